@@ -9,12 +9,30 @@
 #include <thread>
 #include <future>
 #include <queue>
+#include <array>
+#include <cmath>
+#include <cstdlib>
 
 using namespace jluna;
 
 int main()
 {
-    initialize(1);
+    // ### TIME TO FIRST SAFE_CALL ###
+
+    // set JLUNA_SYSIMAGE to the image built by the jluna_sysimage target to compare against the default image
+    {
+        auto* image = std::getenv("JLUNA_SYSIMAGE");
+        auto start = std::chrono::steady_clock::now();
+
+        initialize(1, false, "", image == nullptr ? "" : image);
+        volatile auto* res = jluna::safe_call(jl_get_function(jl_base_module, "identity"), jl_box_int64(1));
+
+        auto duration = std::chrono::duration_cast<Benchmark::Duration>(std::chrono::steady_clock::now() - start);
+        Benchmark::add_results("Time to First safe_call", Benchmark::Result(
+            image == nullptr ? "Time to First safe_call" : "Time to First safe_call (jluna_sysimage)",
+            duration, duration, duration, duration, 1, ""
+        ));
+    }
 
     // ### ACCESSING JULIA-SIDE VALUES ###
 
@@ -65,11 +83,24 @@ int main()
         volatile auto* f = Main.get<unsafe::Function*>("f");
     });
 
+    // Module::binding, looked up once
+    Main.safe_eval("x_global = 1234");
+    auto x_binding = Main.binding<Int64>("x_global");
+    Benchmark::run("module: binding", n_reps, [&](){
+        volatile Int64 x = x_binding.get();
+    });
+
     // C-API: eval
     Benchmark::run("eval: get", n_reps / 4, [](){
         volatile auto* f = (unsafe::Function*) jl_eval_string("return f");
     });
 
+    // parsed and lowered once
+    auto compiled_get = CompiledExpression("return f");
+    Benchmark::run("CompiledExpression: get", n_reps / 4, [&](){
+        volatile auto* f = (unsafe::Function*) compiled_get.evaluate<unsafe::Value*>();
+    });
+
     Benchmark::conclude();
     Benchmark::save();
     return 0;
@@ -109,6 +140,22 @@ int main()
         x_proxy = to_box;
     });
 
+    // assign 500 variables, once per variable vs. as a single batch
+    auto batch = AssignmentBatch();
+    for (size_t i = 0; i < 500; ++i)
+        batch.add("x" + std::to_string(i), Int64(i));
+
+    Main.create_or_assign_many(batch);
+
+    Benchmark::run_as_base("Module::assign (500 Variables)", n_reps / 1000, [&](){
+        for (size_t i = 0; i < 500; ++i)
+            Main.assign("x" + std::to_string(i), Int64(i));
+    });
+
+    Benchmark::run("Module::assign_many (500 Variables)", n_reps / 1000, [&](){
+        Main.assign_many(batch);
+    });
+
     //Benchmark::conclude();
     //Benchmark::save();
     //return 0;
@@ -186,6 +233,96 @@ int main()
         jl_call0(jl_task_f);
     });
 
+    // many arguments, each passed to the trampoline directly
+    Main.create_or_assign("task_f8", as_julia_function<void(Int64, Int64, Int64, Int64, Int64, Int64, Int64, Int64)>(
+        [](Int64, Int64, Int64, Int64, Int64, Int64, Int64, Int64){ task_f(); }
+    ));
+    auto* jl_task_f8 = unsafe::get_function(jl_main_module, "task_f8"_sym);
+
+    std::array<unsafe::Value*, 8> task_f8_args;
+    for (size_t i = 0; i < task_f8_args.size(); ++i)
+        task_f8_args.at(i) = jl_box_int64(i);
+
+    Benchmark::run("Call C++-Function in Julia (8 Arguments)", n_reps, [&](){
+        jl_call(jl_task_f8, task_f8_args.data(), task_f8_args.size());
+    });
+
+    // isbits signature, called from a Julia-side loop, compared to ccalling a C-function
+    Main.safe_eval(R"(
+        function call_ldexp_n_times(n)
+            out = 0.0
+            for i in 1:n
+                out += ccall(:ldexp, Cdouble, (Cdouble, Cint), Float64(i), Cint(1))
+            end
+            return out
+        end
+
+        function call_n_times(f, n)
+            out = 0.0
+            for i in 1:n
+                out += f(Float64(i), Cint(1))
+            end
+            return out
+        end
+    )");
+
+    auto* call_ldexp_n_times = unsafe::get_function(jl_main_module, "call_ldexp_n_times"_sym);
+    auto* call_n_times = unsafe::get_function(jl_main_module, "call_n_times"_sym);
+    auto* n_calls = jl_box_int64(1000);
+    auto n_calls_id = unsafe::gc_preserve(n_calls);
+
+    static auto ldexp_f = [](double x, int32_t e) -> double {
+        return std::ldexp(x, e);
+    };
+
+    auto* native_ldexp = register_native_function<double(double, int32_t)>(ldexp_f);
+    auto native_ldexp_id = unsafe::gc_preserve(native_ldexp);
+
+    auto* boxed_ldexp = as_julia_function<double(double, int32_t)>(ldexp_f);
+    auto boxed_ldexp_id = unsafe::gc_preserve(boxed_ldexp);
+
+    Benchmark::run_as_base("ccall C-Function in Julia", n_reps / 1000, [&](){
+        jl_call1(call_ldexp_n_times, n_calls);
+    });
+
+    Benchmark::run("Call Native C++-Function in Julia", n_reps / 1000, [&](){
+        jl_call2(call_n_times, native_ldexp, n_calls);
+    });
+
+    Benchmark::run("Call Boxed C++-Function in Julia", n_reps / 1000, [&](){
+        jl_call2(call_n_times, boxed_ldexp, n_calls);
+    });
+
+    unsafe::gc_release(native_ldexp_id);
+    unsafe::gc_release(boxed_ldexp_id);
+    unsafe::gc_release(n_calls_id);
+
+    // broadcast over a dense array, once per element vs. once for the whole array
+    Main.safe_eval("broadcast_xs = rand(Float64, 1_000_000)");
+    Main.create_or_assign("native_square", register_native_function<double(double)>([](double x) -> double {
+        return x * x;
+    }));
+    Main.create_or_assign("batch_square", register_batch_function<double, double>([](std::span<const double> in, std::span<double> out) {
+        for (size_t i = 0; i < in.size(); ++i)
+            out[i] = in[i] * in[i];
+    }));
+
+    auto* broadcast_native = (unsafe::Function*) jl_eval_string("() -> native_square.(broadcast_xs)");
+    auto broadcast_native_id = unsafe::gc_preserve(broadcast_native);
+    auto* broadcast_batch = (unsafe::Function*) jl_eval_string("() -> batch_square.(broadcast_xs)");
+    auto broadcast_batch_id = unsafe::gc_preserve(broadcast_batch);
+
+    Benchmark::run_as_base("Broadcast Native C++-Function", n_reps / 10000, [&](){
+        jl_call0(broadcast_native);
+    });
+
+    Benchmark::run("Broadcast Batch C++-Function", n_reps / 10000, [&](){
+        jl_call0(broadcast_batch);
+    });
+
+    unsafe::gc_release(broadcast_native_id);
+    unsafe::gc_release(broadcast_batch_id);
+
     //Benchmark::conclude();
     //Benchmark::save();
     //return 0;
@@ -248,6 +385,47 @@ int main()
     //Benchmark::save();
     //return 0;
 
+    // ### JLUNA KERNELS ###
+
+    n_reps = 1000;
+    Array<Float64, 1> kernel_array = Main.safe_eval("return rand(Float64, 1_000_000)");
+
+    // sum using the C-API, as is commonly done
+    Benchmark::run_as_base("Sum: jl_arrayref", n_reps, [&](){
+
+        auto* arr = (jl_array_t*) static_cast<unsafe::Value*>(kernel_array);
+        volatile Float64 sum = 0;
+        for (size_t i = 0; i < jl_array_len(arr); ++i)
+            sum = sum + jl_unbox_float64(jl_arrayref(arr, i));
+    });
+
+    // sum in Julia
+    auto* julia_sum = unsafe::get_function(jl_base_module, "sum"_sym);
+    Benchmark::run("Sum: Base.sum", n_reps, [&](){
+        volatile auto* sum = jl_call1(julia_sum, static_cast<unsafe::Value*>(kernel_array));
+    });
+
+    for (auto instruction_set : {kernels::InstructionSet::SCALAR, kernels::InstructionSet::AVX2, kernels::InstructionSet::AVX512})
+    {
+        if (not kernels::is_supported(instruction_set))
+            continue;
+
+        kernels::set_instruction_set(instruction_set);
+        std::string name = instruction_set == kernels::InstructionSet::SCALAR ? "scalar" : (instruction_set == kernels::InstructionSet::AVX2 ? "AVX2" : "AVX-512");
+
+        Benchmark::run("Sum: kernels::sum (" + name + ")", n_reps, [&](){
+            volatile Float64 sum = kernels::sum(kernel_array);
+        });
+
+        Benchmark::run("Sum: kernels::sum (" + name + ", threadpool)", n_reps, [&](){
+            volatile Float64 sum = kernels::sum(kernel_array, true);
+        });
+    }
+
+    //Benchmark::conclude();
+    //Benchmark::save();
+    //return 0;
+
     // ### JLUNA TASK ###
 
     // setup 1-thread threapool
@@ -315,6 +493,56 @@ int main()
     thread.detach();
     queue_cv.notify_all();
 
+    // calling Julia from a C++-side thread: adopted thread vs. hop through the threadpool
+    if (ThreadGuard::is_supported())
+    {
+        static auto* identity = unsafe::get_function(jl_base_module, "identity"_sym);
+        n_reps = 100000;
+
+        Benchmark::run_as_base("threading: call from ThreadPool task", n_reps, [&]()
+        {
+            auto t = ThreadPool::create<void()>([]() {
+                jluna::safe_call(identity, jl_nothing);
+            });
+            t.schedule();
+            t.join();
+        });
+
+        auto adopted = std::thread([&]()
+        {
+            auto guard = ThreadGuard();
+            Benchmark::run("threading: call from adopted std::thread", n_reps, [&]()
+            {
+                jluna::safe_call(identity, jl_nothing);
+            });
+        });
+        adopted.join();
+    }
+
+    // task churn: many short-lived tasks alive at the same time, exercises the threadpool task registry
+    n_reps = 10000;
+    Benchmark::run("threading: jluna::Task churn (256 tasks)", n_reps, [&]()
+    {
+        std::vector<Task<void>> tasks;
+        tasks.reserve(256);
+
+        for (size_t i = 0; i < 256; ++i)
+            tasks.push_back(ThreadPool::create<void()>([]() {}));
+
+        for (auto& t : tasks)
+            t.schedule();
+
+        for (auto& t : tasks)
+            t.join();
+    });
+
+    Benchmark::run("threading: ThreadPool::spawn_batch churn (256 tasks)", n_reps, [&]()
+    {
+        static auto callables = std::vector<std::function<void()>>(256, []() {});
+        auto group = ThreadPool::spawn_batch(callables);
+        group.wait_all();
+    });
+
     Benchmark::conclude();
     return 0;
 }
@@ -140,12 +140,36 @@ namespace jluna
     template<is_boxable V, size_t R>
     Vector<V> Array<V, R>::operator[](const std::vector<size_t>& range) const
     {
+        const size_t n = get_n_elements();
+        for (size_t i : range)
+        {
+            if (i >= n)
+            {
+                std::stringstream str;
+                str << "0-based index " << i << " out of range for array of length " << n << std::endl;
+                throw std::out_of_range(str.str().c_str());
+            }
+        }
+
         gc_pause;
         auto* out = unsafe::new_array((unsafe::Value*) as_julia_type<V>::type(), range.size());
         auto* me = operator jl_array_t*();
 
-        for (size_t i = 0; i < range.size(); ++i)
-            jl_arrayset(out, jl_arrayref(me, range.at(i)), i);
+        if (jl_isbits(as_julia_type<V>::type()))
+        {
+            // isbits: copy bytes directly, avoids boxing each element
+            const size_t elsize = me->elsize;
+            auto* from = reinterpret_cast<char*>(me->data);
+            auto* to = reinterpret_cast<char*>(out->data);
+
+            for (size_t i = 0; i < range.size(); ++i)
+                std::memcpy(to + i * elsize, from + range[i] * elsize, elsize);
+        }
+        else
+        {
+            for (size_t i = 0; i < range.size(); ++i)
+                jl_arrayset(out, jl_arrayref(me, range[i]), i);
+        }
 
         gc_unpause;
         return Vector<V>((unsafe::Value*) out);
@@ -154,15 +178,13 @@ namespace jluna
     template<is_boxable V, size_t R>
     Vector<V> Array<V, R>::operator[](const GeneratorExpression& gen) const
     {
-        gc_pause;
-        auto res = Vector<V>();
-        res.reserve(gen.size());
+        std::vector<size_t> index;
+        index.reserve(gen.size());
 
         for (auto it : gen)
-            res.push_back(this->operator[](unbox<size_t>(it)));
+            index.push_back(unbox<size_t>(it));
 
-        gc_unpause;
-        return res;
+        return operator[](index);
     }
 
     template<is_boxable V, size_t R>
@@ -385,6 +407,121 @@ namespace jluna
         gc_unpause;
     }
 
+    template<is_boxable V>
+    void Vector<V>::erase(size_t first, size_t last)
+    {
+        auto n = this->get_n_elements();
+        if (first > last or last > n)
+        {
+            std::stringstream str;
+            str << "0-based range [" << first << ", " << last << ") out of range for array of length " << n << std::endl;
+            throw std::out_of_range(str.str().c_str());
+        }
+
+        if (first == last)
+            return;
+
+        gc_pause;
+        jl_array_del_at((jl_array_t*) _content->value(), first, last - first);
+        gc_unpause;
+    }
+
+    template<is_boxable V>
+    template<Iterable Range_t> requires std::is_convertible_v<typename Range_t::value_type, V>
+    void Vector<V>::insert(size_t pos, const Range_t& range)
+    {
+        static unsafe::Function* insert_range = unsafe::get_function("jluna"_sym, "insert_range!"_sym);
+
+        auto n = this->get_n_elements();
+        if (pos > n)
+        {
+            std::stringstream str;
+            str << "0-based index " << pos << " out of range for insertion into array of length " << n << std::endl;
+            throw std::out_of_range(str.str().c_str());
+        }
+
+        if (std::begin(range) == std::end(range))
+            return;
+
+        gc_pause;
+        if (is_memory_compatible())
+        {
+            jl_array_grow_at((jl_array_t*) _content->value(), pos, std::distance(std::begin(range), std::end(range)));
+            copy_to_data(range, pos);
+        }
+        else
+        {
+            jl_call3(insert_range, _content->value(), jl_box_uint64(pos + 1), (unsafe::Value*) box_range(range));
+            forward_last_exception();
+        }
+        gc_unpause;
+    }
+
+    template<is_boxable V>
+    template<Iterable Range_t> requires std::is_convertible_v<typename Range_t::value_type, V>
+    void Vector<V>::append(const Range_t& range)
+    {
+        static unsafe::Function* append = unsafe::get_function(jl_base_module, "append!"_sym);
+
+        if (std::begin(range) == std::end(range))
+            return;
+
+        gc_pause;
+        if (is_memory_compatible())
+        {
+            auto* array = (jl_array_t*) _content->value();
+            auto offset = jl_array_len(array);
+            jl_array_grow_end(array, std::distance(std::begin(range), std::end(range)));
+            copy_to_data(range, offset);
+        }
+        else
+        {
+            jl_call2(append, _content->value(), (unsafe::Value*) box_range(range));
+            forward_last_exception();
+        }
+        gc_unpause;
+    }
+
+    template<is_boxable V>
+    bool Vector<V>::is_memory_compatible() const
+    {
+        // char is boxed as 32-bit Char, so it is excluded even though it is arithmetic
+        if constexpr (std::is_arithmetic_v<V> and not std::is_same_v<V, char>)
+        {
+            auto* array = (jl_array_t*) _content->value();
+            return not array->flags.ptrarray and array->elsize == sizeof(V);
+        }
+        else
+            return false;
+    }
+
+    template<is_boxable V>
+    template<typename Range_t>
+    void Vector<V>::copy_to_data(const Range_t& range, size_t offset)
+    {
+        auto* data = reinterpret_cast<V*>(((jl_array_t*) _content->value())->data) + offset;
+
+        // only reached if is_memory_compatible, which requires V to be arithmetic
+        if constexpr (std::is_arithmetic_v<V> and std::is_same_v<typename Range_t::value_type, V> and std::contiguous_iterator<decltype(std::begin(range))>)
+            std::memcpy(data, &(*std::begin(range)), std::distance(std::begin(range), std::end(range)) * sizeof(V));
+        else
+            for (const auto& value : range)
+                *(data++) = static_cast<V>(value);
+    }
+
+    template<is_boxable V>
+    template<typename Range_t>
+    unsafe::Array* Vector<V>::box_range(const Range_t& range)
+    {
+        auto* out = jl_alloc_vec_any(std::distance(std::begin(range), std::end(range)));
+
+        size_t i = 0;
+        for (const auto& value : range)
+            jl_arrayset(out, box<V>(static_cast<V>(value)), i++);
+
+        return out;
+    }
+
     template<is_boxable V>
     template<is_boxable T>
     void Vector<V>::push_front(T value)
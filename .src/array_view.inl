@@ -0,0 +1,277 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+namespace jluna
+{
+    /// @brief box array view
+    /// @param view
+    /// @returns pointer to Julia-side SubArray
+    template<typename T,
+        typename Value_t = typename T::value_type,
+        std::enable_if_t<std::is_same_v<T, ArrayView<Value_t>>, bool> = true>
+    unsafe::Value* box(T value)
+    {
+        return value.operator unsafe::Value*();
+    }
+
+    /// @brief unbox to array view
+    template<typename T,
+        typename Value_t = typename T::value_type,
+        std::enable_if_t<std::is_same_v<T, ArrayView<Value_t>>, bool> = true>
+    T unbox(unsafe::Value* in)
+    {
+        return ArrayView<Value_t>(in);
+    }
+
+    namespace detail
+    {
+        template<typename Value_t>
+        struct as_julia_type_aux<ArrayView<Value_t>>
+        {
+            static inline const std::string type_name = "SubArray{" + as_julia_type_aux<Value_t>::type_name + "}";
+        };
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, bool>>
+    Slice::Slice(T index)
+        : _kind(SCALAR), _first(index), _last(index + 1), _step(1)
+    {}
+
+    inline Slice::Slice(All)
+        : _kind(ALL), _first(0), _last(0), _step(1)
+    {}
+
+    template<typename T, typename U, std::enable_if_t<std::is_integral_v<T> and std::is_integral_v<U>, bool>>
+    Slice::Slice(T first, U last)
+        : _kind(RANGE), _first(first), _last(last), _step(1)
+    {}
+
+    template<typename T, typename U, typename V, std::enable_if_t<std::is_integral_v<T> and std::is_integral_v<U> and std::is_integral_v<V>, bool>>
+    Slice::Slice(T first, U last, V step)
+        : _kind(RANGE), _first(first), _last(last), _step(step)
+    {
+        if (step <= 0)
+            throw std::invalid_argument("In jluna::Slice: step " + std::to_string(step) + " is invalid, only steps > 0 are permitted");
+    }
+
+    template<typename Array_t, typename Value_t, size_t... Is>
+    ArrayView<Value_t> detail::SliceableArray<Array_t, Value_t, std::index_sequence<Is...>>::slice(slice_argument_t<Is>... slices) const
+    {
+        return static_cast<const Array_t*>(this)->make_view({slices...});
+    }
+
+    template<is_boxable V, size_t R>
+    ArrayView<V> Array<V, R>::make_view(const std::vector<Slice>& slices) const
+    {
+        // (kind, first, length, step) per dimension, c.f. jluna.make_view
+        std::vector<Int64> descriptor;
+        descriptor.reserve(4 * R);
+
+        for (size_t i = 0; i < R; ++i)
+        {
+            const auto& slice = slices[i];
+            const Int64 dim = get_dimension(i);
+
+            if (slice._kind == Slice::ALL)
+            {
+                descriptor.insert(descriptor.end(), {Slice::ALL, 0, dim, 1});
+                continue;
+            }
+
+            Int64 length = slice._last > slice._first ? (slice._last - slice._first + slice._step - 1) / slice._step : 0;
+
+            if (slice._first < 0 or (length > 0 and slice._first + (length - 1) * slice._step >= dim))
+            {
+                std::stringstream str;
+                str << "In jluna::Array::slice: range [" << slice._first << ", " << slice._last << ") out of range for array of size " << dim << " along dimension " << i << std::endl;
+                throw std::out_of_range(str.str().c_str());
+            }
+
+            descriptor.insert(descriptor.end(), {slice._kind, slice._first, length, slice._step});
+        }
+
+        static auto* make_view = unsafe::get_function("jluna"_sym, "make_view"_sym);
+
+        gc_pause;
+        auto* view = jluna::safe_call(make_view, _content->value(), box<std::vector<Int64>>(descriptor));
+        auto out = ArrayView<V>(view, descriptor);
+        gc_unpause;
+        return out;
+    }
+
+    template<is_boxable V>
+    ArrayView<V>::ArrayView(unsafe::Value* value, jl_sym_t* symbol)
+        : Proxy(value, symbol)
+    {
+        static auto* get_view_slices = unsafe::get_function("jluna"_sym, "get_view_slices"_sym);
+
+        gc_pause;
+        initialize(unbox<std::vector<Int64>>(jluna::safe_call(get_view_slices, value)));
+        gc_unpause;
+    }
+
+    template<is_boxable V>
+    ArrayView<V>::ArrayView(Proxy* proxy)
+        : Proxy(*proxy)
+    {
+        static auto* get_view_slices = unsafe::get_function("jluna"_sym, "get_view_slices"_sym);
+
+        gc_pause;
+        initialize(unbox<std::vector<Int64>>(jluna::safe_call(get_view_slices, _content->value())));
+        gc_unpause;
+    }
+
+    template<is_boxable V>
+    ArrayView<V>::ArrayView(unsafe::Value* value, const std::vector<Int64>& slices)
+        : Proxy(value, nullptr)
+    {
+        initialize(slices);
+    }
+
+    template<is_boxable V>
+    void ArrayView<V>::initialize(const std::vector<Int64>& slices)
+    {
+        _parent = (unsafe::Array*) jl_get_field(_content->value(), "parent");
+
+        detail::assert_type((unsafe::DataType*) jl_typeof((unsafe::Value*) _parent), (unsafe::DataType*) jl_array_type);
+        detail::assert_type((unsafe::DataType*) detail::array_value_type(_parent), (unsafe::DataType*) as_julia_type<V>::type());
+
+        _offset = 0;
+        _n_elements = 1;
+        _sizes.clear();
+        _strides.clear();
+
+        Int64 parent_stride = 1;
+        for (size_t i = 0; i < slices.size() / 4; ++i)
+        {
+            auto kind = slices[4*i];
+            auto first = slices[4*i+1];
+            auto length = slices[4*i+2];
+            auto step = slices[4*i+3];
+
+            _offset += first * parent_stride;
+
+            if (kind != 0)
+            {
+                _sizes.push_back(length);
+                _strides.push_back(step * parent_stride);
+                _n_elements *= length;
+            }
+
+            parent_stride *= jl_array_dim(_parent, i);
+        }
+    }
+
+    template<is_boxable V>
+    size_t ArrayView<V>::to_parent_index(size_t i) const
+    {
+        Int64 out = _offset;
+        for (size_t dim = 0; dim < _sizes.size(); ++dim)
+        {
+            out += (i % _sizes[dim]) * _strides[dim];
+            i /= _sizes[dim];
+        }
+
+        return out;
+    }
+
+    template<is_boxable V>
+    template<is_unboxable T>
+    T ArrayView<V>::operator[](size_t i) const
+    {
+        if (i >= _n_elements)
+        {
+            std::stringstream str;
+            str << "0-based index " << i << " out of range for view of length " << _n_elements << std::endl;
+            throw std::out_of_range(str.str().c_str());
+        }
+
+        return unbox<T>(jl_arrayref(_parent, to_parent_index(i)));
+    }
+
+    template<is_boxable V>
+    template<is_unboxable T, typename... Args, std::enable_if_t<(std::is_integral_v<Args> and ...), bool>>
+    T ArrayView<V>::at(Args... in) const
+    {
+        if (sizeof...(Args) != _sizes.size())
+            throw std::invalid_argument("In jluna::ArrayView::at: expected " + std::to_string(_sizes.size()) + " indices, got " + std::to_string(sizeof...(Args)));
+
+        std::array<size_t, sizeof...(Args)> indices = {size_t(in)...};
+        size_t index = 0;
+        size_t mul = 1;
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            if (indices[i] >= _sizes[i])
+            {
+                std::stringstream str;
+                str << "0-based index " << indices[i] << " out of range for view of size " << _sizes[i] << " along dimension " << i << std::endl;
+                throw std::out_of_range(str.str().c_str());
+            }
+
+            index += indices[i] * mul;
+            mul *= _sizes[i];
+        }
+
+        return operator[]<T>(index);
+    }
+
+    template<is_boxable V>
+    template<is_boxable T>
+    void ArrayView<V>::set(size_t i, T value)
+    {
+        if (i >= _n_elements)
+        {
+            std::stringstream str;
+            str << "0-based index " << i << " out of range for view of length " << _n_elements << std::endl;
+            throw std::out_of_range(str.str().c_str());
+        }
+
+        gc_pause;
+        jl_arrayset(_parent, box<V>(value), to_parent_index(i));
+        gc_unpause;
+    }
+
+    template<is_boxable V>
+    size_t ArrayView<V>::get_n_elements() const
+    {
+        return _n_elements;
+    }
+
+    template<is_boxable V>
+    size_t ArrayView<V>::get_rank() const
+    {
+        return _sizes.size();
+    }
+
+    template<is_boxable V>
+    size_t ArrayView<V>::size(size_t dimension_index) const
+    {
+        return dimension_index < _sizes.size() ? _sizes[dimension_index] : 1;
+    }
+
+    template<is_boxable V>
+    bool ArrayView<V>::empty() const
+    {
+        return _n_elements == 0;
+    }
+
+    template<is_boxable V>
+    unsafe::Array* ArrayView<V>::get_parent() const
+    {
+        return _parent;
+    }
+
+    template<is_boxable V>
+    template<size_t Rank>
+    Array<V, Rank> ArrayView<V>::copy() const
+    {
+        if (Rank != get_rank())
+            throw std::invalid_argument("In jluna::ArrayView::copy: view is of rank " + std::to_string(get_rank()) + ", but result array was declared with rank " + std::to_string(Rank));
+
+        static auto* copy = unsafe::get_function(jl_base_module, "copy"_sym);
+        return Array<V, Rank>(jluna::safe_call(copy, _content->value()));
+    }
+}
@@ -10,16 +10,16 @@
 namespace jluna
 {
     template<typename Function_t, typename... Args_t, std::enable_if_t<std::is_void_v<std::invoke_result_t<Function_t, Args_t...>>, bool>>
-    static unsafe::Value* box_function_result(Function_t f, Args_t... args)
+    static unsafe::Value* box_function_result(Function_t&& f, Args_t&&... args)
     {
-        f(args...);
+        std::forward<Function_t>(f)(std::forward<Args_t>(args)...);
         return jl_nothing;
     }
 
     template<typename Function_t, typename... Args_t, std::enable_if_t<not std::is_void_v<std::invoke_result_t<Function_t, Args_t...>>, bool>>
-    static unsafe::Value* box_function_result(Function_t f, Args_t... args)
+    static unsafe::Value* box_function_result(Function_t&& f, Args_t&&... args)
     {
-        return box(f(args...));
+        return box(std::forward<Function_t>(f)(std::forward<Args_t>(args)...));
     }
 
     template<is_julia_value_pointer T>
@@ -0,0 +1,275 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+namespace jluna
+{
+    namespace detail
+    {
+        inline void BroadcastValueLeaf::write_shape(std::stringstream& str, size_t& i)
+        {
+            str << "x" << ++i;
+        }
+
+        template<size_t N>
+        void BroadcastValueLeaf::collect(std::array<unsafe::Value*, N>& out, size_t& i) const
+        {
+            out[i++] = _value;
+        }
+
+        template<typename T>
+        void BroadcastScalarLeaf<T>::write_shape(std::stringstream& str, size_t& i)
+        {
+            str << "x" << ++i;
+        }
+
+        template<typename T>
+        template<size_t N>
+        void BroadcastScalarLeaf<T>::collect(std::array<unsafe::Value*, N>& out, size_t& i) const
+        {
+            out[i++] = box<T>(_value);
+        }
+
+        template<typename T>
+        auto as_broadcast_node(const T& x)
+        {
+            if constexpr (is_broadcast_expression<T>::value)
+                return x;
+            else if constexpr (is_broadcast_array<T>::value)
+                return BroadcastValueLeaf{(unsafe::Value*) static_cast<const unsafe::Value*>(x)};
+            else
+                return BroadcastScalarLeaf<T>{x};
+        }
+
+        template<typename Op_t, typename... Ts>
+        auto make_broadcast_expression(const Ts&... xs)
+        {
+            return BroadcastExpression<Op_t, decltype(as_broadcast_node(xs))...>(as_broadcast_node(xs)...);
+        }
+    }
+
+    template<typename Op_t, typename... Args_t>
+    BroadcastExpression<Op_t, Args_t...>::BroadcastExpression(Args_t... args)
+        : _args(args...)
+    {}
+
+    template<typename Op_t, typename... Args_t>
+    template<typename... Ts>
+    void BroadcastExpression<Op_t, Args_t...>::write_list(std::stringstream& str, size_t& i)
+    {
+        bool first = true;
+        auto write = [&]<typename T>() {
+            if (not first)
+                str << ", ";
+
+            first = false;
+            T::write_shape(str, i);
+        };
+
+        (write.template operator()<Ts>(), ...);
+    }
+
+    template<typename Op_t, typename... Args_t>
+    void BroadcastExpression<Op_t, Args_t...>::write_shape(std::stringstream& str, size_t& i)
+    {
+        if constexpr (std::is_same_v<Op_t, detail::BroadcastCall>)
+        {
+            // first argument is the function itself: x1.(x2, ...)
+            [&]<typename F, typename... Rest>(std::tuple<F, Rest...>*) {
+                F::write_shape(str, i);
+                str << ".(";
+                write_list<Rest...>(str, i);
+                str << ")";
+            }((std::tuple<Args_t...>*) nullptr);
+        }
+        else
+        {
+            str << Op_t::julia_name << ".(";
+            write_list<Args_t...>(str, i);
+            str << ")";
+        }
+    }
+
+    template<typename Op_t, typename... Args_t>
+    std::string BroadcastExpression<Op_t, Args_t...>::get_shape()
+    {
+        std::stringstream str;
+        size_t i = 0;
+        write_shape(str, i);
+        return str.str();
+    }
+
+    template<typename Op_t, typename... Args_t>
+    template<size_t N>
+    void BroadcastExpression<Op_t, Args_t...>::collect(std::array<unsafe::Value*, N>& out, size_t& i) const
+    {
+        std::apply([&](const auto&... args) {
+            (args.collect(out, i), ...);
+        }, _args);
+    }
+
+    template<typename Op_t, typename... Args_t>
+    unsafe::Function* BroadcastExpression<Op_t, Args_t...>::get_kernel(bool in_place)
+    {
+        static auto compile = [](bool in_place) -> unsafe::Function* {
+
+            std::stringstream str;
+            str << "return (" << (in_place ? "destination, " : "");
+
+            for (size_t i = 1; i <= n_leaves; ++i)
+                str << "x" << i << (i != n_leaves ? ", " : "");
+
+            str << ") -> ";
+
+            if (in_place)
+                str << "(destination .= " << get_shape() << "; return nothing)";
+            else
+                str << get_shape();
+
+            auto* out = jluna::safe_eval(str.str());
+            [[maybe_unused]] auto id = unsafe::gc_preserve(out);  // kernel lives until the end of the program
+            return out;
+        };
+
+        if (in_place)
+        {
+            static auto* kernel = compile(true);
+            return kernel;
+        }
+        else
+        {
+            static auto* kernel = compile(false);
+            return kernel;
+        }
+    }
+
+    template<typename Op_t, typename... Args_t>
+    template<typename Destination_t>
+    auto BroadcastExpression<Op_t, Args_t...>::evaluate(Destination_t* destination) const
+    {
+        constexpr bool in_place = not std::is_same_v<Destination_t, void>;
+        constexpr size_t n_args = n_leaves + (in_place ? 1 : 0);
+
+        auto* kernel = get_kernel(in_place);
+
+        gc_pause;
+        std::array<unsafe::Value*, n_args> args;
+        size_t i = 0;
+
+        if constexpr (in_place)
+            args[i++] = (unsafe::Value*) static_cast<const unsafe::Value*>(*destination);
+
+        collect(args, i);
+
+        unsafe::Value* result;
+        try
+        {
+            result = [&]<size_t... Is>(std::index_sequence<Is...>) {
+                return jluna::safe_call(kernel, args[Is]...);
+            }(std::make_index_sequence<n_args>());
+        }
+        catch (...)
+        {
+            gc_unpause;
+            throw;
+        }
+
+        if constexpr (in_place)
+        {
+            gc_unpause;
+        }
+        else
+        {
+            // root the result before the gc is re-enabled
+            auto out = Proxy(result);
+            gc_unpause;
+            return out;
+        }
+    }
+
+    template<typename Op_t, typename... Args_t>
+    template<typename Destination_t>
+    void BroadcastExpression<Op_t, Args_t...>::materialize_into(Destination_t& destination) const
+    {
+        static_assert(detail::is_broadcast_array<Destination_t>::value, "destination has to be a jluna::Array, jluna::Vector or jluna::ArrayView");
+        evaluate(&destination);
+    }
+
+    template<typename Op_t, typename... Args_t>
+    Proxy BroadcastExpression<Op_t, Args_t...>::materialize() const
+    {
+        return evaluate<void>(nullptr);
+    }
+
+    // ###
+
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator+(const A& a, const B& b)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastPlus>(a, b);
+    }
+
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator-(const A& a, const B& b)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastMinus>(a, b);
+    }
+
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator*(const A& a, const B& b)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastTimes>(a, b);
+    }
+
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator/(const A& a, const B& b)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastDivide>(a, b);
+    }
+
+    template<is_broadcastable A>
+    auto operator-(const A& a)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastMinus>(a);
+    }
+
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto min(const A& a, const B& b)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastMin>(a, b);
+    }
+
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto max(const A& a, const B& b)
+    {
+        return detail::make_broadcast_expression<detail::BroadcastMax>(a, b);
+    }
+
+    template<is_broadcast_operand... Args_t> requires (is_broadcastable<Args_t> or ...)
+    auto broadcast(unsafe::Function* f, const Args_t&... args)
+    {
+        return BroadcastExpression<detail::BroadcastCall, detail::BroadcastValueLeaf, decltype(detail::as_broadcast_node(args))...>(
+            detail::BroadcastValueLeaf{f},
+            detail::as_broadcast_node(args)...
+        );
+    }
+
+    template<is_broadcast_operand... Args_t> requires (is_broadcastable<Args_t> or ...)
+    auto broadcast(const Proxy& f, const Args_t&... args)
+    {
+        return broadcast((unsafe::Function*) static_cast<const unsafe::Value*>(f), args...);
+    }
+
+    template<typename Destination_t, typename Op_t, typename... Args_t> requires detail::is_broadcast_array<Destination_t>::value
+    void materialize(Destination_t& destination, const BroadcastExpression<Op_t, Args_t...>& expression)
+    {
+        expression.materialize_into(destination);
+    }
+
+    template<typename Op_t, typename... Args_t>
+    Proxy materialize(const BroadcastExpression<Op_t, Args_t...>& expression)
+    {
+        return expression.materialize();
+    }
+}
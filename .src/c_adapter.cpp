@@ -2,65 +2,72 @@
 
 #include <include/julia_wrapper.hpp>
 #include <include/cppcall.hpp>
+#include <include/multi_threading.hpp>
+#include <include/executor.hpp>
+#include <include/channel.hpp>
 
 #include <iostream>
 #include <thread>
+#include <atomic>
 
 #include <.src/c_adapter.hpp>
 
-jluna::unsafe::Value* jluna_make(void* function_ptr, int n_args)
+jluna::unsafe::Value* jluna_make(void* function_ptr, void* invoke_ptr, void* free_ptr, jl_value_t* return_type, jl_value_t* argument_types)
 {
     gc_pause;
     static auto* make = (jl_function_t*) jl_eval_string("return jluna.cppcall.make_unnamed_function");
-    auto* res = jluna::safe_call(make, jl_box_voidpointer(function_ptr), jl_box_int64(n_args));
+    auto* res = jluna::safe_call(make, jl_box_voidpointer(function_ptr), jl_box_voidpointer(invoke_ptr), jl_box_voidpointer(free_ptr), return_type, argument_types);
     gc_unpause;
     return res;
 }
 
-void jluna_free_lambda(void* in, int n_args)
+size_t jluna_invoke_from_task(size_t function_ptr)
 {
-    if (n_args == 0)
-        delete (jluna::detail::lambda_0_arg*) in;
-    else if (n_args == 1)
-        delete (jluna::detail::lambda_1_arg*) in;
-    else if (n_args == 2)
-        delete (jluna::detail::lambda_2_arg*) in;
-    else if (n_args == 3)
-        delete (jluna::detail::lambda_3_arg*) in;
-    else
-        throw std::invalid_argument("In c_adapter::jluna_free_lambda: " + std::to_string(n_args) + " is a invalid number of arguments");
+    return reinterpret_cast<size_t>(
+        (*reinterpret_cast<jluna::detail::TaskCallable*>(function_ptr))()
+    );
 }
 
-jluna::unsafe::Value* jluna_invoke_lambda_0(void* function_ptr)
+void jluna_invoke_detached(size_t function_ptr)
 {
-    return (*reinterpret_cast<jluna::detail::lambda_0_arg*>(function_ptr))();
+    auto* function = reinterpret_cast<jluna::detail::TaskCallable*>(function_ptr);
+    (*function)();
+    delete function;
 }
 
-jluna::unsafe::Value* jluna_invoke_lambda_1(void* function_ptr, jluna::unsafe::Value* x)
+void jluna_mutex_notify(uint32_t* state)
 {
-    return (*reinterpret_cast<jluna::detail::lambda_1_arg*>(function_ptr))(x);
+    std::atomic_ref<uint32_t>(*state).notify_all();
 }
 
-jluna::unsafe::Value* jluna_invoke_lambda_2(void* function_ptr, jluna::unsafe::Value* x, jluna::unsafe::Value* y)
+int jluna_executor_drain(size_t executor_ptr)
 {
-    return (*reinterpret_cast<jluna::detail::lambda_2_arg*>(function_ptr))(x, y);
+    return reinterpret_cast<jluna::Executor*>(executor_ptr)->drain();
 }
 
-jluna::unsafe::Value* jluna_invoke_lambda_3(void* function_ptr, jluna::unsafe::Value* x, jluna::unsafe::Value* y, jluna::unsafe::Value* z)
+int jluna_channel_push(size_t channel_ptr, const void* value, int was_waiting)
 {
-    return (*reinterpret_cast<jluna::detail::lambda_3_arg*>(function_ptr))(x, y, z);
+    return reinterpret_cast<jluna::detail::ChannelInterface*>(channel_ptr)->julia_push(value, was_waiting != 0);
 }
 
-void* jluna_to_pointer(jl_value_t* in)
+int jluna_channel_pop(size_t channel_ptr, void* out, int was_waiting)
 {
-    return (void*) in;
+    return reinterpret_cast<jluna::detail::ChannelInterface*>(channel_ptr)->julia_pop(out, was_waiting != 0);
 }
 
-size_t jluna_invoke_from_task(size_t function_ptr)
+void jluna_channel_close(size_t channel_ptr)
 {
-    return reinterpret_cast<size_t>(
-        (*reinterpret_cast<std::function<jluna::unsafe::Value*()>*>(function_ptr))()
-    );
+    reinterpret_cast<jluna::detail::ChannelInterface*>(channel_ptr)->close();
+}
+
+int jluna_channel_is_closed(size_t channel_ptr)
+{
+    return reinterpret_cast<jluna::detail::ChannelInterface*>(channel_ptr)->is_closed() ? 1 : 0;
+}
+
+size_t jluna_channel_size(size_t channel_ptr)
+{
+    return reinterpret_cast<jluna::detail::ChannelInterface*>(channel_ptr)->size();
 }
 
 bool jluna_verify()
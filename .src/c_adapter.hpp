@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <include/julia_wrapper.hpp>
 #include <functional>
@@ -13,39 +14,61 @@
 
 extern "C"
 {
-    namespace jluna::detail
-    {
-        using lambda_0_arg = std::function<jl_value_t *()>;
-        using lambda_1_arg = std::function<jl_value_t *(jl_value_t *)>;
-        using lambda_2_arg = std::function<jl_value_t *(jl_value_t *, jl_value_t *)>;
-        using lambda_3_arg = std::function<jl_value_t *(jl_value_t *, jl_value_t *, jl_value_t *)>;
-        //using lambda_n_arg = std::function<jl_value_t*(const std::vector<jl_value_t*>&)>;
-    }
-
-    /// @brief construct an UnnamedFunctionProxy object
-    /// @param function_ptr: allocated with `new`
-    /// @param n_args: number of arguments: 0, 1, 2, 3 or -1
-    /// @returns ptr to UnnamedFunctionProxy object
-    jl_value_t* jluna_make(void* function_ptr, int n_args);
-
-    jl_value_t* jluna_invoke_lambda_0(void* function_ptr);
-    jl_value_t* jluna_invoke_lambda_1(void* function_ptr, jl_value_t*);
-    jl_value_t* jluna_invoke_lambda_2(void* function_ptr, jl_value_t*,  jl_value_t*);
-    jl_value_t* jluna_invoke_lambda_3(void* function_ptr, jl_value_t*,  jl_value_t*, jl_value_t*);
-
-    /// @brief `delete` a function pointer held
-    /// @param pointer to function
-    /// @param n_args: 0, 1, 2, 3 or -1
-    void jluna_free_lambda(void* function_ptr, int n_args);
-
-    /// @brief get pointer to arbitrary object
-    void* jluna_to_pointer(jl_value_t*);
+    /// @brief construct a jluna.cppcall.UnnamedFunction object
+    /// @param function_ptr: C++-side function object, allocated with `new`
+    /// @param invoke_ptr: function with signature (void* function_ptr, jl_value_t*...) -> jl_value_t*, taking exactly one argument per element of argument_types after function_ptr
+    /// @param free_ptr: function with signature (void* function_ptr) -> void, deallocates the function object
+    /// @param return_type: declared Julia-side type of the result
+    /// @param argument_types: Tuple type of the declared Julia-side types of the arguments
+    /// @returns ptr to UnnamedFunction object
+    jl_value_t* jluna_make(void* function_ptr, void* invoke_ptr, void* free_ptr, jl_value_t* return_type, jl_value_t* argument_types);
 
     /// @brief invoke function ptr, used within threadpool
     /// @param function_pointer
     /// @returns result pointer
     size_t jluna_invoke_from_task(size_t function_ptr);
 
+    /// @brief invoke function ptr, then deallocate it, used for future continuations
+    /// @param function_pointer
+    void jluna_invoke_detached(size_t function_ptr);
+
+    /// @brief wake up C++-side threads waiting on a jluna::Mutex, used when unlocking a contended mutex from Julia
+    /// @param state: pointer to the mutexes atomic word
+    void jluna_mutex_notify(uint32_t* state);
+
+    /// @brief execute queued items of a jluna::Executor, called by its worker tasks
+    /// @param executor_ptr
+    /// @returns 0 if the queue was empty, 1 if items were executed, 2 if the executor was stopped
+    int jluna_executor_drain(size_t executor_ptr);
+
+    /// @brief push an element into a jluna::Channel, called by jluna.CppChannel
+    /// @param channel_ptr: pointer to jluna::detail::ChannelInterface
+    /// @param value: pointer to the element
+    /// @param was_waiting: whether the calling task was woken after a previous call returned 0
+    /// @returns 1 if the element was pushed, 2 if the channel is closed, 0 if it is full
+    int jluna_channel_push(size_t channel_ptr, const void* value, int was_waiting);
+
+    /// @brief pop an element from a jluna::Channel, called by jluna.CppChannel
+    /// @param channel_ptr: pointer to jluna::detail::ChannelInterface
+    /// @param out: pointer the element is written to
+    /// @param was_waiting: whether the calling task was woken after a previous call returned 0
+    /// @returns 1 if an element was popped, 2 if the channel is closed and empty, 0 if it is empty
+    int jluna_channel_pop(size_t channel_ptr, void* out, int was_waiting);
+
+    /// @brief close a jluna::Channel
+    /// @param channel_ptr: pointer to jluna::detail::ChannelInterface
+    void jluna_channel_close(size_t channel_ptr);
+
+    /// @brief is a jluna::Channel closed
+    /// @param channel_ptr: pointer to jluna::detail::ChannelInterface
+    /// @returns 1 if closed, 0 otherwise
+    int jluna_channel_is_closed(size_t channel_ptr);
+
+    /// @brief get number of elements in a jluna::Channel
+    /// @param channel_ptr: pointer to jluna::detail::ChannelInterface
+    /// @returns number
+    size_t jluna_channel_size(size_t channel_ptr);
+
     /// @brief verify c_adapter is working, used for test
     /// @returns true
     bool jluna_verify();
@@ -0,0 +1,82 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <include/cancellation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace jluna
+{
+    CancellationToken::CancellationToken()
+    {
+        static auto* new_cancellation_token = unsafe::get_function("jluna"_sym, "new_cancellation_token"_sym);
+        _value = unsafe::call(new_cancellation_token);
+        _value_id = unsafe::gc_preserve(_value);
+
+        // both fields are a Threads.Atomic, whose only field is the word itself
+        _state = reinterpret_cast<uint32_t*>(jl_get_nth_field(_value, 0));
+        _deadline = reinterpret_cast<uint64_t*>(jl_get_nth_field(_value, 1));
+    }
+
+    CancellationToken::CancellationToken(const CancellationToken& other)
+        : _value(other._value), _state(other._state), _deadline(other._deadline)
+    {
+        _value_id = unsafe::gc_preserve(_value);
+    }
+
+    CancellationToken& CancellationToken::operator=(const CancellationToken& other)
+    {
+        if (&other == this)
+            return *this;
+
+        auto id = unsafe::gc_preserve(other._value);
+        unsafe::gc_release(_value_id);
+
+        _value = other._value;
+        _value_id = id;
+        _state = other._state;
+        _deadline = other._deadline;
+        return *this;
+    }
+
+    CancellationToken::~CancellationToken()
+    {
+        unsafe::gc_release(_value_id);
+    }
+
+    CancellationToken::operator unsafe::Value*() const
+    {
+        return _value;
+    }
+
+    void CancellationToken::cancel()
+    {
+        std::atomic_ref<uint32_t>(*_state).store(1);
+    }
+
+    void CancellationToken::cancel_after(std::chrono::nanoseconds timeout)
+    {
+        // jl_hrtime is the clock used by Base.time_ns
+        uint64_t now = jl_hrtime();
+        uint64_t ns = uint64_t(std::max<int64_t>(0, timeout.count()));
+        uint64_t deadline = ns > std::numeric_limits<uint64_t>::max() - now ? std::numeric_limits<uint64_t>::max() : now + ns;
+
+        std::atomic_ref<uint64_t>(*_deadline).store(deadline);
+    }
+
+    bool CancellationToken::is_cancelled() const
+    {
+        return std::atomic_ref<uint32_t>(*_state).load() != 0
+            or jl_hrtime() >= std::atomic_ref<uint64_t>(*_deadline).load();
+    }
+
+    bool is_cancelled()
+    {
+        static auto* is_cancelled = unsafe::get_function("jluna"_sym, "is_cancelled"_sym);
+        return jl_unbox_bool(jluna::safe_call(is_cancelled));
+    }
+}
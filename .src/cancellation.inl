@@ -0,0 +1,22 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+namespace jluna
+{
+    template<is_julia_value_pointer... Args_t>
+    unsafe::Value* call_with_token(const CancellationToken& token, unsafe::Function* function, Args_t... args)
+    {
+        static auto* with_cancellation_token = unsafe::get_function("jluna"_sym, "with_cancellation_token"_sym);
+        return jluna::safe_call(with_cancellation_token, (unsafe::Value*) token, (unsafe::Value*) function, args...);
+    }
+
+    template<is_julia_value_pointer... Args_t>
+    unsafe::Value* call_with_deadline(std::chrono::nanoseconds timeout, unsafe::Function* function, Args_t... args)
+    {
+        auto token = CancellationToken();
+        token.cancel_after(timeout);
+        return call_with_token(token, function, args...);
+    }
+}
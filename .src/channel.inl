@@ -0,0 +1,382 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <cstring>
+
+namespace jluna
+{
+    template<typename T>
+    Channel<T>::Channel(size_t capacity)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("In jluna::Channel: capacity has to be at least 1");
+
+        _buffer.resize(capacity);
+    }
+
+    template<typename T>
+    Channel<T>::~Channel()
+    {
+        if (_view == nullptr)
+            return;
+
+        static auto* invalidate = unsafe::get_function("jluna"_sym, "invalidate_cpp_channel"_sym);
+        close();
+        jluna::safe_call(invalidate, _view);
+        unsafe::gc_release(_view_id);
+    }
+
+    template<typename T>
+    Channel<T>::operator unsafe::Value*() requires is_native_function_type<T>
+    {
+        if (_view != nullptr)
+            return _view;
+
+        static auto* new_cpp_channel = unsafe::get_function("jluna"_sym, "new_cpp_channel"_sym);
+        static auto* get_async_handle = unsafe::get_function("jluna"_sym, "get_async_handle"_sym);
+        static auto* async_send = reinterpret_cast<int(*)(void*)>(jl_unbox_voidpointer(jl_eval_string("return cglobal(:uv_async_send)")));
+
+        gc_pause;
+        auto* view = jluna::safe_call(new_cpp_channel, (unsafe::Value*) as_julia_type<T>::type(), jl_box_voidpointer(static_cast<detail::ChannelInterface*>(this)));
+        auto view_id = unsafe::gc_preserve(view);
+        auto* handle = jl_unbox_voidpointer(jluna::safe_call(get_async_handle, view));
+        gc_unpause;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _async_handle = handle;
+            _async_send = async_send;
+        }
+
+        _view = view;
+        _view_id = view_id;
+        return _view;
+    }
+
+    template<typename T>
+    void Channel<T>::push_locked(T&& value)
+    {
+        _buffer[(_head + _size) % _buffer.size()].emplace(std::move(value));
+        _size += 1;
+    }
+
+    template<typename T>
+    T Channel<T>::pop_locked()
+    {
+        auto& slot = _buffer[_head];
+        T out = std::move(slot.value());
+        slot.reset();
+
+        _head = (_head + 1) % _buffer.size();
+        _size -= 1;
+        return out;
+    }
+
+    template<typename T>
+    template<typename Predicate_t>
+    void Channel<T>::wait(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, Predicate_t predicate)
+    {
+        if (predicate())
+            return;
+
+        if (jl_get_pgcstack() == nullptr)
+        {
+            cv.wait(lock, predicate);
+            return;
+        }
+
+        // leaving the GC-safe region blocks while the GC is running, which may wait for another Julia thread that is trying to acquire the lock
+        auto* ptls = jl_current_task->ptls;
+        do
+        {
+            int8_t state = jl_gc_safe_enter(ptls);
+            cv.wait(lock, predicate);
+            lock.unlock();
+            jl_gc_safe_leave(ptls, state);
+            lock.lock();
+        }
+        while (not predicate());
+    }
+
+    template<typename T>
+    void Channel<T>::notify_julia()
+    {
+        _async_send(_async_handle);
+    }
+
+    template<typename T>
+    bool Channel<T>::push(T value)
+    {
+        bool wake_julia;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            wait(_not_full, lock, [&](){
+                return _size < _buffer.size() or _closed;
+            });
+
+            if (_closed)
+                return false;
+
+            push_locked(std::move(value));
+            wake_julia = _n_julia_waiters > 0;
+        }
+
+        _not_empty.notify_one();
+        if (wake_julia)
+            notify_julia();
+
+        return true;
+    }
+
+    template<typename T>
+    bool Channel<T>::try_push(T value)
+    {
+        bool wake_julia;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_closed or _size == _buffer.size())
+                return false;
+
+            push_locked(std::move(value));
+            wake_julia = _n_julia_waiters > 0;
+        }
+
+        _not_empty.notify_one();
+        if (wake_julia)
+            notify_julia();
+
+        return true;
+    }
+
+    template<typename T>
+    template<Iterable Range_t>
+    size_t Channel<T>::push_n(const Range_t& values)
+    {
+        size_t n_pushed = 0;
+        auto it = values.begin();
+
+        while (it != values.end())
+        {
+            size_t n_pushed_now = 0;
+            bool wake_julia;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                wait(_not_full, lock, [&](){
+                    return _size < _buffer.size() or _closed;
+                });
+
+                if (_closed)
+                    return n_pushed;
+
+                while (it != values.end() and _size < _buffer.size())
+                {
+                    push_locked(T(*it));
+                    it++;
+                    n_pushed_now += 1;
+                }
+
+                wake_julia = _n_julia_waiters > 0;
+            }
+
+            if (n_pushed_now == 1)
+                _not_empty.notify_one();
+            else
+                _not_empty.notify_all();
+
+            if (wake_julia)
+                notify_julia();
+
+            n_pushed += n_pushed_now;
+        }
+
+        return n_pushed;
+    }
+
+    template<typename T>
+    std::optional<T> Channel<T>::pop()
+    {
+        std::optional<T> out;
+        bool wake_julia;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            wait(_not_empty, lock, [&](){
+                return _size > 0 or _closed;
+            });
+
+            if (_size == 0)
+                return std::nullopt;
+
+            out = pop_locked();
+            wake_julia = _n_julia_waiters > 0;
+        }
+
+        _not_full.notify_one();
+        if (wake_julia)
+            notify_julia();
+
+        return out;
+    }
+
+    template<typename T>
+    std::optional<T> Channel<T>::try_pop()
+    {
+        std::optional<T> out;
+        bool wake_julia;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_size == 0)
+                return std::nullopt;
+
+            out = pop_locked();
+            wake_julia = _n_julia_waiters > 0;
+        }
+
+        _not_full.notify_one();
+        if (wake_julia)
+            notify_julia();
+
+        return out;
+    }
+
+    template<typename T>
+    std::vector<T> Channel<T>::pop_n(size_t n)
+    {
+        std::vector<T> out;
+        if (n == 0)
+            return out;
+
+        bool wake_julia;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            wait(_not_empty, lock, [&](){
+                return _size > 0 or _closed;
+            });
+
+            out.reserve(std::min(n, _size));
+            while (_size > 0 and out.size() < n)
+                out.push_back(pop_locked());
+
+            wake_julia = _n_julia_waiters > 0 and not out.empty();
+        }
+
+        if (out.size() == 1)
+            _not_full.notify_one();
+        else if (out.size() > 1)
+            _not_full.notify_all();
+
+        if (wake_julia)
+            notify_julia();
+
+        return out;
+    }
+
+    template<typename T>
+    void Channel<T>::close()
+    {
+        bool wake_julia;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+            wake_julia = _n_julia_waiters > 0;
+        }
+
+        _not_full.notify_all();
+        _not_empty.notify_all();
+
+        if (wake_julia)
+            notify_julia();
+    }
+
+    template<typename T>
+    bool Channel<T>::is_closed() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _closed;
+    }
+
+    template<typename T>
+    size_t Channel<T>::size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _size;
+    }
+
+    template<typename T>
+    size_t Channel<T>::capacity() const
+    {
+        return _buffer.size();
+    }
+
+    template<typename T>
+    int Channel<T>::julia_push(const void* value, bool was_waiting)
+    {
+        if constexpr (not is_native_function_type<T>)
+            return 2;
+        else
+        {
+            bool wake_julia;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (was_waiting)
+                    _n_julia_waiters -= 1;
+
+                if (_closed)
+                    return 2;
+
+                if (_size == _buffer.size())
+                {
+                    _n_julia_waiters += 1;
+                    return 0;
+                }
+
+                T x;
+                std::memcpy(&x, value, sizeof(T));
+                push_locked(std::move(x));
+                wake_julia = _n_julia_waiters > 0;
+            }
+
+            _not_empty.notify_one();
+            if (wake_julia)
+                notify_julia();
+
+            return 1;
+        }
+    }
+
+    template<typename T>
+    int Channel<T>::julia_pop(void* out, bool was_waiting)
+    {
+        if constexpr (not is_native_function_type<T>)
+            return 2;
+        else
+        {
+            bool wake_julia;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (was_waiting)
+                    _n_julia_waiters -= 1;
+
+                if (_size == 0)
+                {
+                    if (_closed)
+                        return 2;
+
+                    _n_julia_waiters += 1;
+                    return 0;
+                }
+
+                T x = pop_locked();
+                std::memcpy(out, &x, sizeof(T));
+                wake_julia = _n_julia_waiters > 0;
+            }
+
+            _not_full.notify_one();
+            if (wake_julia)
+                notify_julia();
+
+            return 1;
+        }
+    }
+}
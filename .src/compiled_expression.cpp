@@ -0,0 +1,71 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <include/compiled_expression.hpp>
+
+namespace jluna
+{
+    CompiledExpression::CompiledExpression(const std::string& code, unsafe::Module* module)
+        : CompiledExpression(code, {}, module)
+    {}
+
+    CompiledExpression::CompiledExpression(const std::string& code, const std::vector<std::string>& parameters, unsafe::Module* module)
+        : _code(code), _module(module), _n_parameters(parameters.size())
+    {
+        static auto* compile_expression = unsafe::get_function("jluna"_sym, "compile_expression"_sym);
+
+        gc_pause;
+        _value = jluna::safe_call(compile_expression, (unsafe::Value*) module, box<std::string>(code), box<std::vector<std::string>>(parameters));
+        _value_id = unsafe::gc_preserve(_value);
+        gc_unpause;
+    }
+
+    CompiledExpression::CompiledExpression(const CompiledExpression& other)
+        : _code(other._code), _module(other._module), _n_parameters(other._n_parameters), _value(other._value)
+    {
+        _value_id = unsafe::gc_preserve(_value);
+    }
+
+    CompiledExpression& CompiledExpression::operator=(const CompiledExpression& other)
+    {
+        if (&other == this)
+            return *this;
+
+        auto id = unsafe::gc_preserve(other._value);
+        unsafe::gc_release(_value_id);
+
+        _code = other._code;
+        _module = other._module;
+        _n_parameters = other._n_parameters;
+        _value = other._value;
+        _value_id = id;
+        return *this;
+    }
+
+    CompiledExpression::~CompiledExpression()
+    {
+        unsafe::gc_release(_value_id);
+    }
+
+    size_t CompiledExpression::n_parameters() const
+    {
+        return _n_parameters;
+    }
+
+    const std::string& CompiledExpression::get_code() const
+    {
+        return _code;
+    }
+
+    void CompiledExpression::throw_if_wrong_number_of_arguments(size_t n) const
+    {
+        if (n == _n_parameters)
+            return;
+
+        std::stringstream str;
+        str << "In jluna::CompiledExpression: expression has " << _n_parameters << " parameter(s), but " << n << " argument(s) were given";
+        throw std::invalid_argument(str.str());
+    }
+}
@@ -0,0 +1,49 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+namespace jluna
+{
+    template<is_julia_value_pointer... Args_t>
+    unsafe::Value* CompiledExpression::safe_evaluate(Args_t... args) const
+    {
+        throw_if_wrong_number_of_arguments(sizeof...(Args_t));
+
+        if constexpr (sizeof...(Args_t) == 0)
+        {
+            // evaluate the lowered thunk, which skips parsing and lowering
+            static auto* eval = unsafe::get_function(jl_core_module, "eval"_sym);
+            return jluna::safe_call(eval, (unsafe::Value*) _module, _value);
+        }
+        else
+            return jluna::safe_call((unsafe::Function*) _value, args...);
+    }
+
+    template<is_boxable... Args_t>
+    Proxy CompiledExpression::operator()(Args_t&&... args) const
+    {
+        gc_pause;
+        auto out = Proxy(safe_evaluate(box(args)...), nullptr);
+        gc_unpause;
+        return out;
+    }
+
+    template<typename T, is_boxable... Args_t>
+    T CompiledExpression::evaluate(Args_t&&... args) const
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            gc_pause;
+            safe_evaluate(box(args)...);
+            gc_unpause;
+        }
+        else
+        {
+            gc_pause;
+            auto out = unbox<T>(safe_evaluate(box(args)...));
+            gc_unpause;
+            return out;
+        }
+    }
+}
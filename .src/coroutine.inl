@@ -0,0 +1,85 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+namespace jluna
+{
+    template<typename T>
+    TaskAwaiter<T>::TaskAwaiter(Task<T>& task)
+        : _task(&task)
+    {}
+
+    template<typename T>
+    bool TaskAwaiter<T>::await_ready()
+    {
+        return _task->is_done();
+    }
+
+    template<typename T>
+    void TaskAwaiter<T>::await_suspend(std::coroutine_handle<> handle)
+    {
+        if (not ThreadGuard::is_julia_thread())
+            throw std::runtime_error("In jluna::TaskAwaiter::await_suspend: co_await on a jluna::Task requires the awaiting thread to be a Julia thread, construct a jluna::ThreadGuard in C++-side threads before awaiting");
+
+        auto* callable = new detail::TaskCallable();
+        callable->emplace([handle]() -> unsafe::Value* {
+            handle.resume();
+            return jl_nothing;
+        });
+
+        static auto* resume_after = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "resume_after"_sym);
+
+        try
+        {
+            jluna::safe_call(resume_after, static_cast<unsafe::Value*>(*_task), jl_box_uint64(reinterpret_cast<size_t>(callable)));
+        }
+        catch (...)
+        {
+            delete callable;
+            throw;
+        }
+    }
+
+    template<typename T>
+    T TaskAwaiter<T>::await_resume()
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            // rethrows the Julia-side exception if the task failed
+            _task->join();
+        }
+        else
+        {
+            auto value = _task->result().get();
+            if (not value.has_value())
+            {
+                _task->join();
+                throw std::logic_error("In jluna::TaskAwaiter::await_resume: task finished without producing a value");
+            }
+
+            return std::move(value.value());
+        }
+    }
+
+    template<typename T>
+    TaskAwaiter<T> operator co_await(Task<T>& task)
+    {
+        return TaskAwaiter<T>(task);
+    }
+
+    template<typename T>
+    TaskAwaiter<T> operator co_await(Task<T>&& task)
+    {
+        return TaskAwaiter<T>(task);
+    }
+
+    template<typename Function_t, typename... Args_t, typename Result_t>
+    Task<Result_t> async(Function_t f, Args_t... args)
+    {
+        if (not ThreadGuard::is_julia_thread())
+            throw std::runtime_error("In jluna::async: creating a task requires the current thread to be a Julia thread, construct a jluna::ThreadGuard in C++-side threads before calling async");
+
+        return ThreadPool::create<Result_t(Args_t...)>(f, args...);
+    }
+}
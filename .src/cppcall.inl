@@ -13,59 +13,155 @@
 #include <.src/c_adapter.hpp>
 
 #include <unordered_map>
+#include <array>
 #include <functional>
+#include <span>
 
 #pragma once
 
 namespace jluna
 {
-    template<typename Return_t>
-    unsafe::Value* register_function(std::function<Return_t()> f)
+    namespace detail
     {
-        auto* out = new detail::lambda_0_arg([f]() -> unsafe::Value*
+        template<typename Function_t, typename... Args_t>
+        unsafe::Value* CppFunction<Function_t, Args_t...>::invoke(void* self, as_value_pointer_t<Args_t>... args)
         {
-            return box_function_result(f);
-        });
+            return box_function_result(static_cast<CppFunction*>(self)->_function, unbox<Args_t>(args)...);
+        }
 
-        return jluna_make(out, 0);
-    }
+        template<typename Function_t, typename... Args_t>
+        void CppFunction<Function_t, Args_t...>::free(void* self)
+        {
+            delete static_cast<CppFunction*>(self);
+        }
 
-    template<typename Return_t, typename Arg1_t>
-    unsafe::Value* register_function(std::function<Return_t(Arg1_t)> f)
-    {
-        auto* out = new detail::lambda_1_arg([f](unsafe::Value* arg1)
+        template<typename T>
+        unsafe::Value* as_declared_type()
         {
-            return box_function_result(f, unbox<Arg1_t>(arg1));
-        });
+            if constexpr (std::is_void_v<T>)
+                return (unsafe::Value*) jl_nothing_type;
+            else if constexpr (is_primitive<T> and to_julia_type_convertable<T>)
+                return (unsafe::Value*) as_julia_type<T>::type();
+            else
+                return (unsafe::Value*) jl_any_type;
+        }
 
-        return jluna_make(out, 1);
-    }
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        unsafe::Value* make_julia_function(Function_t f, Return_t(*)(Args_t...))
+        {
+            using CppFunction_t = CppFunction<Function_t, Args_t...>;
 
-    template<typename Return_t, typename Arg1_t, typename Arg2_t>
-    unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t)> f)
-    {
-        auto* out = new detail::lambda_2_arg([f](unsafe::Value* arg1, unsafe::Value* arg2)
+            gc_pause;
+            std::array<unsafe::Value*, sizeof...(Args_t)> arg_types = {as_declared_type<Args_t>()...};
+            auto* arg_tuple_type = (unsafe::Value*) jl_apply_tuple_type_v(arg_types.data(), arg_types.size());
+
+            auto* out = new CppFunction_t{std::move(f)};
+            auto* res = jluna_make(
+                out,
+                reinterpret_cast<void*>(&CppFunction_t::invoke),
+                reinterpret_cast<void*>(&CppFunction_t::free),
+                as_declared_type<Return_t>(),
+                arg_tuple_type
+            );
+            gc_unpause;
+            return res;
+        }
+
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        Return_t NativeFunction<Function_t, Return_t, Args_t...>::invoke(void* self, Args_t... args)
+        {
+            return static_cast<NativeFunction*>(self)->_function(args...);
+        }
+
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        void NativeFunction<Function_t, Return_t, Args_t...>::free(void* self)
+        {
+            delete static_cast<NativeFunction*>(self);
+        }
+
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        unsafe::Value* make_native_function(Function_t f, Return_t(*)(Args_t...))
+        {
+            static_assert(std::is_void_v<Return_t> or is_native_function_type<Return_t>, "return type of a native function has to be void or an isbits type with C-compatible layout");
+            static_assert((is_native_function_type<Args_t> and ...), "argument types of a native function have to be isbits types with C-compatible layout");
+
+            static auto* make = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_native_function"_sym);
+
+            using NativeFunction_t = NativeFunction<Function_t, Return_t, Args_t...>;
+            auto* out = new NativeFunction_t{std::move(f)};
+
+            unsafe::Value* return_type;
+            if constexpr (std::is_void_v<Return_t>)
+                return_type = (unsafe::Value*) jl_nothing_type;
+            else
+                return_type = (unsafe::Value*) as_julia_type<Return_t>::type();
+
+            gc_pause;
+            auto* res = jluna::safe_call(
+                make,
+                jl_box_voidpointer(out),
+                jl_box_voidpointer(reinterpret_cast<void*>(&NativeFunction_t::invoke)),
+                jl_box_voidpointer(reinterpret_cast<void*>(&NativeFunction_t::free)),
+                return_type,
+                (unsafe::Value*) as_julia_type<Args_t>::type()...
+            );
+            gc_unpause;
+            return res;
+        }
+
+        template<typename Function_t, typename In_t, typename Out_t>
+        void BatchFunction<Function_t, In_t, Out_t>::invoke(void* self, const In_t* in, Out_t* out, size_t n)
         {
-            return box_function_result(f, unbox<Arg1_t>(arg1), unbox<Arg2_t>(arg2));
-        });
+            static_cast<BatchFunction*>(self)->_function(std::span<const In_t>(in, n), std::span<Out_t>(out, n));
+        }
 
-        return jluna_make(out, 2);
+        template<typename Function_t, typename In_t, typename Out_t>
+        void BatchFunction<Function_t, In_t, Out_t>::free(void* self)
+        {
+            delete static_cast<BatchFunction*>(self);
+        }
     }
 
-    template<typename Return_t, typename Arg1_t, typename Arg2_t, typename Arg3_t>
-    unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t, Arg3_t)> f)
+    template<typename Return_t, typename... Args_t>
+    unsafe::Value* register_function(std::function<Return_t(Args_t...)> f)
     {
-        auto* out = new detail::lambda_3_arg([f](unsafe::Value* arg1, unsafe::Value* arg2, unsafe::Value* arg3)
-        {
-            return box_function_result(f, unbox<Arg1_t>(arg1), unbox<Arg2_t>(arg2), unbox<Arg3_t>(arg3));
-        });
+        return detail::make_julia_function(std::move(f), (Return_t(*)(Args_t...)) nullptr);
+    }
 
-        return jluna_make(out, 3);
+    template<typename Signature, typename Lambda_t>
+    unsafe::Value* as_julia_function(Lambda_t lambda)
+    {
+        // the lambda is stored as is, without std::function
+        return detail::make_julia_function(std::move(lambda), (Signature*) nullptr);
+    }
+
+    template<typename Signature, typename Lambda_t>
+    unsafe::Value* register_native_function(Lambda_t lambda)
+    {
+        return detail::make_native_function(std::move(lambda), (Signature*) nullptr);
     }
 
-    template<typename Function_t, typename _>
-    unsafe::Value* as_julia_function(_ lambda)
+    template<typename In_t, typename Out_t, typename Lambda_t>
+    unsafe::Value* register_batch_function(Lambda_t lambda)
     {
-        return register_function(std::function<Function_t>(lambda));
+        static_assert(is_native_function_type<In_t> and is_native_function_type<Out_t>, "element types of a batch function have to be isbits types with C-compatible layout");
+        static_assert(std::is_invocable_v<Lambda_t, std::span<const In_t>, std::span<Out_t>>, "batch function has to be invocable with (std::span<const In_t>, std::span<Out_t>)");
+
+        static auto* make = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_batch_function"_sym);
+
+        using BatchFunction_t = detail::BatchFunction<Lambda_t, In_t, Out_t>;
+        auto* out = new BatchFunction_t{std::move(lambda)};
+
+        gc_pause;
+        auto* res = jluna::safe_call(
+            make,
+            jl_box_voidpointer(out),
+            jl_box_voidpointer(reinterpret_cast<void*>(&BatchFunction_t::invoke)),
+            jl_box_voidpointer(reinterpret_cast<void*>(&BatchFunction_t::free)),
+            (unsafe::Value*) as_julia_type<In_t>::type(),
+            (unsafe::Value*) as_julia_type<Out_t>::type()
+        );
+        gc_unpause;
+        return res;
     }
-}
\ No newline at end of file
+}
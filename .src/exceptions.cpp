@@ -48,6 +48,19 @@ namespace jluna
             initialized = true;
     }
 
+    namespace detail
+    {
+        void throw_julia_exception(unsafe::Value* exception, const std::string& stacktrace)
+        {
+            static auto* is_cancellation = unsafe::get_function("jluna"_sym, "is_cancellation"_sym);
+
+            if (jl_unbox_bool(jl_call1(is_cancellation, exception)))
+                throw CancellationException(exception, stacktrace);
+
+            throw JuliaException(exception, stacktrace);
+        }
+    }
+
     void forward_last_exception()
     {
         throw_if_uninitialized();
@@ -0,0 +1,305 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <include/executor.hpp>
+#include <include/safe_utilities.hpp>
+
+#include <algorithm>
+
+namespace jluna
+{
+    namespace detail
+    {
+        ExecutorQueue::ExecutorQueue()
+            : _head(&_stub), _tail(&_stub)
+        {}
+
+        void ExecutorQueue::push(ExecutorItem* item)
+        {
+            item->next.store(nullptr, std::memory_order_relaxed);
+            auto* previous = _head.exchange(item, std::memory_order_acq_rel);
+            previous->next.store(item, std::memory_order_release);
+        }
+
+        ExecutorItem* ExecutorQueue::pop()
+        {
+            ExecutorItem* tail = _tail;
+            ExecutorItem* next = tail->next.load(std::memory_order_acquire);
+
+            if (tail == &_stub)
+            {
+                if (next == nullptr)
+                    return nullptr;
+
+                _tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next != nullptr)
+            {
+                _tail = next;
+                return tail;
+            }
+
+            // a producer exchanged _head but did not yet link its item
+            if (tail != _head.load(std::memory_order_acquire))
+                return nullptr;
+
+            push(&_stub);
+            next = tail->next.load(std::memory_order_acquire);
+
+            if (next != nullptr)
+            {
+                _tail = next;
+                return tail;
+            }
+
+            return nullptr;
+        }
+    }
+
+    Executor::Executor(size_t n_workers, size_t max_queue_size, size_t max_batch_size)
+        : _n_workers(n_workers == 0 ? ThreadPool::n_threads() : n_workers),
+          _max_queue_size(max_queue_size),
+          _max_batch_size(max_batch_size)
+    {
+        if (max_queue_size == 0)
+            throw std::invalid_argument("In jluna::Executor: maximum queue size has to be at least 1");
+
+        if (max_batch_size == 0)
+            throw std::invalid_argument("In jluna::Executor: maximum batch size has to be at least 1");
+
+        static auto* make_executor = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_executor"_sym);
+        static auto* get_async_handle = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "get_executor_async_handle"_sym);
+        static auto* async_send = reinterpret_cast<int(*)(void*)>(jl_unbox_voidpointer(jl_eval_string("return cglobal(:uv_async_send)")));
+
+        // set before the workers can run, they only start once this thread yields
+        _async_send = async_send;
+
+        gc_pause;
+        _workers = jluna::safe_call(make_executor, jl_box_uint64(reinterpret_cast<size_t>(this)), jl_box_uint64(_n_workers));
+        _workers_id = unsafe::gc_preserve(_workers);
+        _async_handle = jl_unbox_voidpointer(jluna::safe_call(get_async_handle, _workers));
+        gc_unpause;
+    }
+
+    Executor::~Executor()
+    {
+        _stopped.store(true);
+        wake_all();
+
+        // workers finish the remaining items, then exit
+        static auto* stop_executor = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "stop_executor"_sym);
+        unsafe::call(stop_executor, _workers);
+        unsafe::gc_release(_workers_id);
+    }
+
+    bool Executor::reserve(bool blocking)
+    {
+        if (_stopped.load())
+            throw std::runtime_error("In jluna::Executor: trying to submit to an executor that is shutting down");
+
+        while (true)
+        {
+            size_t depth = _depth.load(std::memory_order_relaxed);
+            if (depth < _max_queue_size)
+            {
+                if (not _depth.compare_exchange_weak(depth, depth + 1, std::memory_order_acq_rel))
+                    continue;
+
+                size_t max = _max_depth.load(std::memory_order_relaxed);
+                while (depth + 1 > max and not _max_depth.compare_exchange_weak(max, depth + 1, std::memory_order_relaxed));
+
+                return true;
+            }
+
+            if (not blocking)
+            {
+                _n_rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            auto has_space = [&](){
+                return _depth.load() < _max_queue_size;
+            };
+
+            if (jl_get_pgcstack() == nullptr)
+            {
+                std::unique_lock<std::mutex> lock(_full_mutex);
+                _full_cv.wait(lock, has_space);
+                continue;
+            }
+
+            // the workers may need to run the GC to make space, so a Julia thread waits in the gc-safe state.
+            // The lock is released before leaving it, because leaving blocks while the GC is running, which may wait for a worker that is trying to acquire the lock
+            auto* ptls = jl_current_task->ptls;
+            int8_t state = jl_gc_safe_enter(ptls);
+            {
+                std::unique_lock<std::mutex> lock(_full_mutex);
+                _full_cv.wait(lock, has_space);
+            }
+            jl_gc_safe_leave(ptls, state);
+        }
+    }
+
+    void Executor::enqueue(detail::ExecutorItem* item)
+    {
+        item->submitted = std::chrono::steady_clock::now();
+        _n_submitted.fetch_add(1, std::memory_order_relaxed);
+
+        _queue.push(item);
+        _n_pending.fetch_add(1);
+
+        if (_n_sleeping.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _sleep_cv.notify_one();
+        }
+        else if (_n_parked.exchange(0) > 0)
+            _async_send(_async_handle);
+    }
+
+    bool Executor::wait_for_items()
+    {
+        bool out;
+        auto* ptls = jl_current_task->ptls;
+        int8_t state = jl_gc_safe_enter(ptls);
+        {
+            std::unique_lock<std::mutex> lock(_sleep_mutex);
+            _n_sleeping.fetch_add(1);
+            out = _sleep_cv.wait_for(lock, _idle_timeout, [&](){
+                return _n_pending.load() > 0 or (_stopped.load() and _depth.load() == 0);
+            });
+            _n_sleeping.fetch_sub(1);
+        }
+        jl_gc_safe_leave(ptls, state);
+        return out;
+    }
+
+    int Executor::park()
+    {
+        // pairs with the exchange in enqueue: either enqueue sees this worker as parked, or this worker sees the new item
+        _n_parked.fetch_add(1);
+        if (_n_pending.load() > 0 or (_stopped.load() and _depth.load() == 0))
+            return 1;
+
+        return 0;
+    }
+
+    void Executor::wake_all()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _sleep_cv.notify_all();
+        }
+
+        if (_n_parked.exchange(0) > 0)
+            _async_send(_async_handle);
+    }
+
+    void Executor::complete(detail::ExecutorItem* item)
+    {
+        auto latency = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - item->submitted).count());
+        delete item;
+
+        _total_latency_ns.fetch_add(latency, std::memory_order_relaxed);
+        uint64_t max = _max_latency_ns.load(std::memory_order_relaxed);
+        while (latency > max and not _max_latency_ns.compare_exchange_weak(max, latency, std::memory_order_relaxed));
+
+        _n_completed.fetch_add(1, std::memory_order_relaxed);
+
+        size_t depth = _depth.fetch_sub(1, std::memory_order_acq_rel);
+        if (depth == _max_queue_size)
+        {
+            std::lock_guard<std::mutex> lock(_full_mutex);
+            _full_cv.notify_all();
+        }
+
+        // last item after shutdown, idle workers may exit now
+        if (depth == 1 and _stopped.load())
+            wake_all();
+    }
+
+    int Executor::drain()
+    {
+        std::vector<detail::ExecutorItem*> items;
+        {
+            // single consumer. Popping never calls into Julia, so other workers block on the lock for at most one batch instead of retrying
+            auto lock = std::unique_lock<std::mutex>(_consumer_mutex);
+
+            while (items.size() < _max_batch_size)
+            {
+                auto* item = _queue.pop();
+                if (item == nullptr)
+                    break;
+
+                _n_pending.fetch_sub(1);
+                items.push_back(item);
+            }
+        }
+
+        if (items.empty())
+        {
+            if (_stopped.load() and _depth.load() == 0)
+                return 2;
+
+            if (wait_for_items())
+                return 1;
+
+            return park();
+        }
+
+        // group items of the same batched function, in order of first occurrence
+        std::vector<std::pair<detail::ExecutorBatchBase*, std::vector<detail::ExecutorItem*>>> batches;
+
+        for (auto* item : items)
+        {
+            if (item->batch == nullptr)
+            {
+                item->callable();
+                complete(item);
+                continue;
+            }
+
+            auto it = std::find_if(batches.begin(), batches.end(), [&](const auto& pair){
+                return pair.first == item->batch;
+            });
+
+            if (it == batches.end())
+                batches.push_back({item->batch, {item}});
+            else
+                it->second.push_back(item);
+        }
+
+        for (auto& pair : batches)
+        {
+            pair.first->process(pair.second);
+            for (auto* item : pair.second)
+                complete(item);
+        }
+
+        return 1;
+    }
+
+    ExecutorMetrics Executor::get_metrics() const
+    {
+        ExecutorMetrics out;
+        out.n_submitted = _n_submitted.load();
+        out.n_completed = _n_completed.load();
+        out.n_rejected = _n_rejected.load();
+        out.n_batches = _n_batches.load();
+        out.queue_depth = _depth.load();
+        out.max_queue_depth = _max_depth.load();
+        out.mean_latency = std::chrono::nanoseconds(out.n_completed == 0 ? 0 : _total_latency_ns.load() / out.n_completed);
+        out.max_latency = std::chrono::nanoseconds(_max_latency_ns.load());
+        return out;
+    }
+
+    size_t Executor::n_workers() const
+    {
+        return _n_workers;
+    }
+}
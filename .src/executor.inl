@@ -0,0 +1,131 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+namespace jluna
+{
+    template<typename In_t, typename Out_t>
+    struct BatchedFunction<In_t, Out_t>::Batch : public detail::ExecutorBatchBase
+    {
+        Batch(Executor* executor, std::function<std::vector<Out_t>(const std::vector<In_t>&)> f)
+            : _executor(executor), _function(std::move(f))
+        {}
+
+        void process(std::vector<detail::ExecutorItem*>& items) override
+        {
+            std::vector<In_t> in;
+            in.reserve(items.size());
+
+            for (auto* item : items)
+                in.push_back(std::move(static_cast<Item*>(item)->in));
+
+            _executor->_n_batches.fetch_add(1, std::memory_order_relaxed);
+
+            try
+            {
+                auto out = _function(in);
+                if (out.size() != items.size())
+                    throw std::invalid_argument("In jluna::BatchedFunction: vectorized function returned " + std::to_string(out.size()) + " results for " + std::to_string(items.size()) + " arguments");
+
+                for (size_t i = 0; i < items.size(); ++i)
+                    detail::FutureHandler::update_future<Out_t>(static_cast<Item*>(items[i])->future, std::move(out[i]));
+            }
+            catch (...)
+            {
+                for (auto* item : items)
+                    detail::FutureHandler::fail_future(static_cast<Item*>(item)->future);
+            }
+        }
+
+        Executor* _executor;
+        std::function<std::vector<Out_t>(const std::vector<In_t>&)> _function;
+    };
+
+    template<typename In_t, typename Out_t>
+    struct BatchedFunction<In_t, Out_t>::Item : public detail::ExecutorItem
+    {
+        In_t in;
+        Future<Out_t> future;
+
+        // keeps the batch alive while the item is queued
+        std::shared_ptr<Batch> owner;
+    };
+
+    template<typename In_t, typename Out_t>
+    BatchedFunction<In_t, Out_t>::BatchedFunction(Executor* executor, std::function<std::vector<Out_t>(const std::vector<In_t>&)> f)
+        : _executor(executor), _batch(std::make_shared<Batch>(executor, std::move(f)))
+    {}
+
+    template<typename In_t, typename Out_t>
+    Future<Out_t> BatchedFunction<In_t, Out_t>::submit(In_t in)
+    {
+        _executor->reserve(true);
+
+        auto* item = new Item();
+        item->in = std::move(in);
+        item->batch = _batch.get();
+        item->owner = _batch;
+
+        auto out = item->future;
+        _executor->enqueue(item);
+        return out;
+    }
+
+    namespace detail
+    {
+        template<typename T, typename Function_t>
+        ExecutorItem* make_executor_item(Function_t f, Future<as_future_value_t<T>> future)
+        {
+            auto* item = new ExecutorItem();
+            item->callable.emplace([f, future]() mutable -> unsafe::Value* {
+
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        f();
+                        FutureHandler::update_future<unsafe::Value*>(future, (unsafe::Value*) jl_nothing);
+                    }
+                    else
+                        FutureHandler::update_future<T>(future, f());
+                }
+                catch (...)
+                {
+                    FutureHandler::fail_future(future);
+                }
+
+                return jl_nothing;
+            });
+
+            return item;
+        }
+    }
+
+    template<typename Function_t, typename T>
+    Future<detail::as_future_value_t<T>> Executor::submit(Function_t f)
+    {
+        reserve(true);
+
+        auto out = Future<detail::as_future_value_t<T>>();
+        enqueue(detail::make_executor_item<T>(f, out));
+        return out;
+    }
+
+    template<typename Function_t, typename T>
+    std::optional<Future<detail::as_future_value_t<T>>> Executor::try_submit(Function_t f)
+    {
+        if (not reserve(false))
+            return std::nullopt;
+
+        auto out = Future<detail::as_future_value_t<T>>();
+        enqueue(detail::make_executor_item<T>(f, out));
+        return out;
+    }
+
+    template<typename In_t, typename Out_t>
+    BatchedFunction<In_t, Out_t> Executor::make_batched(std::function<std::vector<Out_t>(const std::vector<In_t>&)> f)
+    {
+        return BatchedFunction<In_t, Out_t>(this, std::move(f));
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// kernel table declarations, shared by include/kernels.hpp and the kernel implementations in .src/kernels*.cpp
+// this file may not include any Julia header, as it is compiled with instruction-set-specific flags
+
+namespace jluna::kernels::detail
+{
+    // function pointers to one set of kernels, all operating on raw dense memory
+    template<typename T>
+    struct KernelTable
+    {
+        T (*sum)(const T*, size_t);
+        T (*minimum)(const T*, size_t);
+        T (*maximum)(const T*, size_t);
+        T (*dot)(const T*, const T*, size_t);
+        T (*sum_of_squares)(const T*, size_t);
+        void (*axpy)(T, const T*, T*, size_t);
+        void (*histogram)(const T*, size_t, T, T, size_t, size_t*);
+    };
+
+    // nullptr if the instruction set was not enabled at compile time
+    template<typename T>
+    const KernelTable<T>* get_scalar_table();
+
+    template<typename T>
+    const KernelTable<T>* get_avx2_table();
+
+    template<typename T>
+    const KernelTable<T>* get_avx512_table();
+
+    template<> const KernelTable<float>* get_scalar_table<float>();
+    template<> const KernelTable<double>* get_scalar_table<double>();
+    template<> const KernelTable<float>* get_avx2_table<float>();
+    template<> const KernelTable<double>* get_avx2_table<double>();
+    template<> const KernelTable<float>* get_avx512_table<float>();
+    template<> const KernelTable<double>* get_avx512_table<double>();
+}
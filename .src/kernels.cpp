@@ -0,0 +1,103 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <include/kernels.hpp>
+#include <.src/kernels_simd.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+namespace jluna::kernels
+{
+    namespace detail
+    {
+        template<>
+        const KernelTable<float>* get_scalar_table<float>()
+        {
+            static const auto table = make_kernel_table<ScalarTraits<float>>();
+            return &table;
+        }
+
+        template<>
+        const KernelTable<double>* get_scalar_table<double>()
+        {
+            static const auto table = make_kernel_table<ScalarTraits<double>>();
+            return &table;
+        }
+
+        // does the CPU support the instruction set, regardless of whether jluna was compiled with it
+        static bool cpu_supports(InstructionSet instruction_set)
+        {
+            #if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+                if (instruction_set == InstructionSet::AVX2)
+                    return __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma");
+                else if (instruction_set == InstructionSet::AVX512)
+                    return __builtin_cpu_supports("avx512f");
+            #endif
+
+            return instruction_set == InstructionSet::SCALAR;
+        }
+
+        template<typename T>
+        static const KernelTable<T>* get_table(InstructionSet instruction_set)
+        {
+            switch (instruction_set)
+            {
+                case InstructionSet::AVX512:
+                    return get_avx512_table<T>();
+                case InstructionSet::AVX2:
+                    return get_avx2_table<T>();
+                default:
+                    return get_scalar_table<T>();
+            }
+        }
+
+        static std::atomic<InstructionSet>& get_current_instruction_set()
+        {
+            static std::atomic<InstructionSet> current = []() -> InstructionSet {
+
+                for (auto instruction_set : {InstructionSet::AVX512, InstructionSet::AVX2})
+                    if (is_supported(instruction_set))
+                        return instruction_set;
+
+                return InstructionSet::SCALAR;
+            }();
+
+            return current;
+        }
+
+        template<>
+        const KernelTable<float>& get_kernel_table<float>()
+        {
+            return *get_table<float>(get_current_instruction_set().load(std::memory_order_relaxed));
+        }
+
+        template<>
+        const KernelTable<double>& get_kernel_table<double>()
+        {
+            return *get_table<double>(get_current_instruction_set().load(std::memory_order_relaxed));
+        }
+    }
+
+    bool is_supported(InstructionSet instruction_set)
+    {
+        return detail::cpu_supports(instruction_set)
+            and detail::get_table<float>(instruction_set) != nullptr
+            and detail::get_table<double>(instruction_set) != nullptr;
+    }
+
+    InstructionSet get_instruction_set()
+    {
+        return detail::get_current_instruction_set().load();
+    }
+
+    void set_instruction_set(InstructionSet instruction_set)
+    {
+        if (not is_supported(instruction_set))
+            throw std::invalid_argument("In jluna::kernels::set_instruction_set: instruction set is not supported by this CPU or was disabled at compile time");
+
+        detail::get_current_instruction_set().store(instruction_set);
+    }
+}
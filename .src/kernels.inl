@@ -0,0 +1,181 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <cmath>
+#include <limits>
+
+namespace jluna::kernels
+{
+    namespace detail
+    {
+        // below this number of elements per chunk, scheduling overhead dominates
+        constexpr size_t _min_grain = 1 << 14;
+
+        template<typename T, size_t R>
+        const T* get_data(const Array<T, R>& array)
+        {
+            return reinterpret_cast<const T*>(static_cast<unsafe::Array*>(array)->data);
+        }
+
+        template<typename T, size_t R>
+        void assert_same_size(const Array<T, R>& a, const Array<T, R>& b, const std::string& function_name)
+        {
+            if (a.get_n_elements() != b.get_n_elements())
+            {
+                std::stringstream str;
+                str << "In jluna::kernels::" << function_name << ": number of elements do not match, " << a.get_n_elements() << " != " << b.get_n_elements() << std::endl;
+                throw std::invalid_argument(str.str());
+            }
+        }
+
+        template<typename T, size_t R>
+        void assert_not_empty(const Array<T, R>& array, const std::string& function_name)
+        {
+            if (array.get_n_elements() == 0)
+                throw std::invalid_argument("In jluna::kernels::" + function_name + ": array may not be empty");
+        }
+
+        // chunk size used when distributing n elements across the threadpool
+        inline size_t get_kernel_grain(size_t n)
+        {
+            return std::max<size_t>(_min_grain, n / (4 * ThreadPool::n_threads()));
+        }
+
+        // apply kernel(first, last) to all chunks, then combine the results in order, such that the result does not depend on scheduling
+        template<typename Result_t, typename Kernel_t, typename Combine_t>
+        Result_t reduce_chunks(size_t n, bool use_threadpool, Kernel_t kernel, Combine_t combine)
+        {
+            if (not use_threadpool or n <= _min_grain)
+                return kernel(0, n);
+
+            const size_t grain = get_kernel_grain(n);
+            std::vector<Result_t> partials((n + grain - 1) / grain);
+
+            parallel_for({0, n}, grain, [&](size_t first, size_t last){
+                partials.at(first / grain) = kernel(first, last);
+            });
+
+            Result_t out = std::move(partials.front());
+            for (size_t i = 1; i < partials.size(); ++i)
+                out = combine(std::move(out), std::move(partials.at(i)));
+
+            return out;
+        }
+    }
+
+    template<is_kernel_value T, size_t R>
+    T sum(const Array<T, R>& array, bool use_threadpool)
+    {
+        const auto& table = detail::get_kernel_table<T>();
+        const T* data = detail::get_data(array);
+
+        return detail::reduce_chunks<T>(array.get_n_elements(), use_threadpool,
+            [&](size_t first, size_t last) { return table.sum(data + first, last - first); },
+            [](T a, T b) { return a + b; }
+        );
+    }
+
+    template<is_kernel_value T, size_t R>
+    T minimum(const Array<T, R>& array, bool use_threadpool)
+    {
+        detail::assert_not_empty(array, "minimum");
+
+        const auto& table = detail::get_kernel_table<T>();
+        const T* data = detail::get_data(array);
+
+        return detail::reduce_chunks<T>(array.get_n_elements(), use_threadpool,
+            [&](size_t first, size_t last) { return table.minimum(data + first, last - first); },
+            [](T a, T b) { return b < a ? b : a; }
+        );
+    }
+
+    template<is_kernel_value T, size_t R>
+    T maximum(const Array<T, R>& array, bool use_threadpool)
+    {
+        detail::assert_not_empty(array, "maximum");
+
+        const auto& table = detail::get_kernel_table<T>();
+        const T* data = detail::get_data(array);
+
+        return detail::reduce_chunks<T>(array.get_n_elements(), use_threadpool,
+            [&](size_t first, size_t last) { return table.maximum(data + first, last - first); },
+            [](T a, T b) { return b > a ? b : a; }
+        );
+    }
+
+    template<is_kernel_value T, size_t R>
+    T dot(const Array<T, R>& a, const Array<T, R>& b, bool use_threadpool)
+    {
+        detail::assert_same_size(a, b, "dot");
+
+        const auto& table = detail::get_kernel_table<T>();
+        const T* a_data = detail::get_data(a);
+        const T* b_data = detail::get_data(b);
+
+        return detail::reduce_chunks<T>(a.get_n_elements(), use_threadpool,
+            [&](size_t first, size_t last) { return table.dot(a_data + first, b_data + first, last - first); },
+            [](T a, T b) { return a + b; }
+        );
+    }
+
+    template<is_kernel_value T, size_t R>
+    void axpy(T alpha, const Array<T, R>& x, Array<T, R>& y, bool use_threadpool)
+    {
+        detail::assert_same_size(x, y, "axpy");
+
+        const auto& table = detail::get_kernel_table<T>();
+        const T* x_data = detail::get_data(x);
+        T* y_data = reinterpret_cast<T*>(y.data());
+        const size_t n = x.get_n_elements();
+
+        if (not use_threadpool or n <= detail::_min_grain)
+        {
+            table.axpy(alpha, x_data, y_data, n);
+            return;
+        }
+
+        parallel_for({0, n}, detail::get_kernel_grain(n), [&](size_t first, size_t last){
+            table.axpy(alpha, x_data + first, y_data + first, last - first);
+        });
+    }
+
+    template<is_kernel_value T, size_t R>
+    T norm(const Array<T, R>& array, bool use_threadpool)
+    {
+        const auto& table = detail::get_kernel_table<T>();
+        const T* data = detail::get_data(array);
+
+        return std::sqrt(detail::reduce_chunks<T>(array.get_n_elements(), use_threadpool,
+            [&](size_t first, size_t last) { return table.sum_of_squares(data + first, last - first); },
+            [](T a, T b) { return a + b; }
+        ));
+    }
+
+    template<is_kernel_value T, size_t R>
+    std::vector<size_t> histogram(const Array<T, R>& array, size_t n_bins, T min, T max, bool use_threadpool)
+    {
+        if (n_bins == 0 or n_bins > size_t(std::numeric_limits<int32_t>::max()))
+            throw std::invalid_argument("In jluna::kernels::histogram: number of bins " + std::to_string(n_bins) + " out of range");
+
+        if (not (min < max))
+            throw std::invalid_argument("In jluna::kernels::histogram: lower bound has to be smaller than upper bound");
+
+        const auto& table = detail::get_kernel_table<T>();
+        const T* data = detail::get_data(array);
+
+        return detail::reduce_chunks<std::vector<size_t>>(array.get_n_elements(), use_threadpool,
+            [&](size_t first, size_t last) {
+                auto out = std::vector<size_t>(n_bins, 0);
+                table.histogram(data + first, last - first, min, max, n_bins, out.data());
+                return out;
+            },
+            [](std::vector<size_t> a, std::vector<size_t> b) {
+                for (size_t i = 0; i < a.size(); ++i)
+                    a[i] += b[i];
+                return a;
+            }
+        );
+    }
+}
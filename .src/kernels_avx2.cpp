@@ -0,0 +1,101 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+// compiled with -mavx2 -mfma (/arch:AVX2 on MSVC) on x86-64, see CMakeLists.txt
+
+#include <.src/kernels_simd.hpp>
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace jluna::kernels::detail
+{
+    namespace
+    {
+        struct Avx2Float
+        {
+            using value_t = float;
+            using vector_t = __m256;
+            static constexpr size_t width = 8;
+
+            static vector_t zero() { return _mm256_setzero_ps(); }
+            static vector_t broadcast(float x) { return _mm256_set1_ps(x); }
+            static vector_t load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+            static void store(float* ptr, vector_t x) { _mm256_storeu_ps(ptr, x); }
+            static vector_t add(vector_t a, vector_t b) { return _mm256_add_ps(a, b); }
+            static vector_t sub(vector_t a, vector_t b) { return _mm256_sub_ps(a, b); }
+            static vector_t fma(vector_t a, vector_t b, vector_t c) { return _mm256_fmadd_ps(a, b, c); }
+            static vector_t min(vector_t a, vector_t b) { return _mm256_min_ps(a, b); }
+            static vector_t max(vector_t a, vector_t b) { return _mm256_max_ps(a, b); }
+            static void to_array(vector_t x, float* out) { _mm256_storeu_ps(out, x); }
+
+            static uint32_t bins(vector_t x, vector_t min, vector_t max, vector_t scale, int32_t* out)
+            {
+                auto in_range = _mm256_and_ps(_mm256_cmp_ps(x, min, _CMP_GE_OQ), _mm256_cmp_ps(x, max, _CMP_LT_OQ));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(x, min), scale)));
+                return static_cast<uint32_t>(_mm256_movemask_ps(in_range));
+            }
+        };
+
+        struct Avx2Double
+        {
+            using value_t = double;
+            using vector_t = __m256d;
+            static constexpr size_t width = 4;
+
+            static vector_t zero() { return _mm256_setzero_pd(); }
+            static vector_t broadcast(double x) { return _mm256_set1_pd(x); }
+            static vector_t load(const double* ptr) { return _mm256_loadu_pd(ptr); }
+            static void store(double* ptr, vector_t x) { _mm256_storeu_pd(ptr, x); }
+            static vector_t add(vector_t a, vector_t b) { return _mm256_add_pd(a, b); }
+            static vector_t sub(vector_t a, vector_t b) { return _mm256_sub_pd(a, b); }
+            static vector_t fma(vector_t a, vector_t b, vector_t c) { return _mm256_fmadd_pd(a, b, c); }
+            static vector_t min(vector_t a, vector_t b) { return _mm256_min_pd(a, b); }
+            static vector_t max(vector_t a, vector_t b) { return _mm256_max_pd(a, b); }
+            static void to_array(vector_t x, double* out) { _mm256_storeu_pd(out, x); }
+
+            static uint32_t bins(vector_t x, vector_t min, vector_t max, vector_t scale, int32_t* out)
+            {
+                auto in_range = _mm256_and_pd(_mm256_cmp_pd(x, min, _CMP_GE_OQ), _mm256_cmp_pd(x, max, _CMP_LT_OQ));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_sub_pd(x, min), scale)));
+                return static_cast<uint32_t>(_mm256_movemask_pd(in_range));
+            }
+        };
+    }
+
+    template<>
+    const KernelTable<float>* get_avx2_table<float>()
+    {
+        static const auto table = make_kernel_table<Avx2Float>();
+        return &table;
+    }
+
+    template<>
+    const KernelTable<double>* get_avx2_table<double>()
+    {
+        static const auto table = make_kernel_table<Avx2Double>();
+        return &table;
+    }
+}
+
+#else
+
+namespace jluna::kernels::detail
+{
+    template<>
+    const KernelTable<float>* get_avx2_table<float>()
+    {
+        return nullptr;
+    }
+
+    template<>
+    const KernelTable<double>* get_avx2_table<double>()
+    {
+        return nullptr;
+    }
+}
+
+#endif
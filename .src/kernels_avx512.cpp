@@ -0,0 +1,101 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+// compiled with -mavx512f (/arch:AVX512 on MSVC) on x86-64, see CMakeLists.txt
+
+#include <.src/kernels_simd.hpp>
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+namespace jluna::kernels::detail
+{
+    namespace
+    {
+        struct Avx512Float
+        {
+            using value_t = float;
+            using vector_t = __m512;
+            static constexpr size_t width = 16;
+
+            static vector_t zero() { return _mm512_setzero_ps(); }
+            static vector_t broadcast(float x) { return _mm512_set1_ps(x); }
+            static vector_t load(const float* ptr) { return _mm512_loadu_ps(ptr); }
+            static void store(float* ptr, vector_t x) { _mm512_storeu_ps(ptr, x); }
+            static vector_t add(vector_t a, vector_t b) { return _mm512_add_ps(a, b); }
+            static vector_t sub(vector_t a, vector_t b) { return _mm512_sub_ps(a, b); }
+            static vector_t fma(vector_t a, vector_t b, vector_t c) { return _mm512_fmadd_ps(a, b, c); }
+            static vector_t min(vector_t a, vector_t b) { return _mm512_min_ps(a, b); }
+            static vector_t max(vector_t a, vector_t b) { return _mm512_max_ps(a, b); }
+            static void to_array(vector_t x, float* out) { _mm512_storeu_ps(out, x); }
+
+            static uint32_t bins(vector_t x, vector_t min, vector_t max, vector_t scale, int32_t* out)
+            {
+                __mmask16 in_range = _mm512_cmp_ps_mask(x, min, _CMP_GE_OQ) & _mm512_cmp_ps_mask(x, max, _CMP_LT_OQ);
+                _mm512_storeu_si512(out, _mm512_cvttps_epi32(_mm512_mul_ps(_mm512_sub_ps(x, min), scale)));
+                return static_cast<uint32_t>(in_range);
+            }
+        };
+
+        struct Avx512Double
+        {
+            using value_t = double;
+            using vector_t = __m512d;
+            static constexpr size_t width = 8;
+
+            static vector_t zero() { return _mm512_setzero_pd(); }
+            static vector_t broadcast(double x) { return _mm512_set1_pd(x); }
+            static vector_t load(const double* ptr) { return _mm512_loadu_pd(ptr); }
+            static void store(double* ptr, vector_t x) { _mm512_storeu_pd(ptr, x); }
+            static vector_t add(vector_t a, vector_t b) { return _mm512_add_pd(a, b); }
+            static vector_t sub(vector_t a, vector_t b) { return _mm512_sub_pd(a, b); }
+            static vector_t fma(vector_t a, vector_t b, vector_t c) { return _mm512_fmadd_pd(a, b, c); }
+            static vector_t min(vector_t a, vector_t b) { return _mm512_min_pd(a, b); }
+            static vector_t max(vector_t a, vector_t b) { return _mm512_max_pd(a, b); }
+            static void to_array(vector_t x, double* out) { _mm512_storeu_pd(out, x); }
+
+            static uint32_t bins(vector_t x, vector_t min, vector_t max, vector_t scale, int32_t* out)
+            {
+                __mmask8 in_range = _mm512_cmp_pd_mask(x, min, _CMP_GE_OQ) & _mm512_cmp_pd_mask(x, max, _CMP_LT_OQ);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm512_cvttpd_epi32(_mm512_mul_pd(_mm512_sub_pd(x, min), scale)));
+                return static_cast<uint32_t>(in_range);
+            }
+        };
+    }
+
+    template<>
+    const KernelTable<float>* get_avx512_table<float>()
+    {
+        static const auto table = make_kernel_table<Avx512Float>();
+        return &table;
+    }
+
+    template<>
+    const KernelTable<double>* get_avx512_table<double>()
+    {
+        static const auto table = make_kernel_table<Avx512Double>();
+        return &table;
+    }
+}
+
+#else
+
+namespace jluna::kernels::detail
+{
+    template<>
+    const KernelTable<float>* get_avx512_table<float>()
+    {
+        return nullptr;
+    }
+
+    template<>
+    const KernelTable<double>* get_avx512_table<double>()
+    {
+        return nullptr;
+    }
+}
+
+#endif
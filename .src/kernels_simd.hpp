@@ -0,0 +1,226 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <.src/kernel_table.hpp>
+
+// generic kernel implementations, instantiated once per instruction set in .src/kernels*.cpp, may only be included by those
+// this file may not include any Julia header, as it is compiled with instruction-set-specific flags
+
+namespace jluna::kernels::detail
+{
+    // everything below has internal linkage, such that code compiled with instruction-set-specific flags
+    // can never be picked by the linker for a translation unit compiled without them
+    namespace
+    {
+        // vector traits of width 1, used as fallback
+        // each traits type Vec_t provides: value_t, vector_t, width, zero, broadcast, load, store, add, sub, fma, min, max, to_array
+        // and bins, which writes truncated bin indices to out and returns a bitmask of lanes inside [min, max)
+        template<typename T>
+        struct ScalarTraits
+        {
+            using value_t = T;
+            using vector_t = T;
+            static constexpr size_t width = 1;
+
+            static vector_t zero() { return T(0); }
+            static vector_t broadcast(T x) { return x; }
+            static vector_t load(const T* ptr) { return *ptr; }
+            static void store(T* ptr, vector_t x) { *ptr = x; }
+            static vector_t add(vector_t a, vector_t b) { return a + b; }
+            static vector_t sub(vector_t a, vector_t b) { return a - b; }
+            static vector_t fma(vector_t a, vector_t b, vector_t c) { return a * b + c; }
+            static vector_t min(vector_t a, vector_t b) { return b < a ? b : a; }
+            static vector_t max(vector_t a, vector_t b) { return b > a ? b : a; }
+            static void to_array(vector_t x, T* out) { *out = x; }
+
+            static uint32_t bins(vector_t x, vector_t min, vector_t max, vector_t scale, int32_t* out)
+            {
+                if (not (x >= min and x < max))
+                    return 0;
+
+                *out = static_cast<int32_t>((x - min) * scale);
+                return 1;
+            }
+        };
+
+        template<typename Vec_t, typename T = typename Vec_t::value_t>
+        T sum_kernel(const T* data, size_t n)
+        {
+            constexpr size_t w = Vec_t::width;
+            auto a0 = Vec_t::zero(), a1 = Vec_t::zero(), a2 = Vec_t::zero(), a3 = Vec_t::zero();
+
+            size_t i = 0;
+            for (; i + 4 * w <= n; i += 4 * w)
+            {
+                a0 = Vec_t::add(a0, Vec_t::load(data + i));
+                a1 = Vec_t::add(a1, Vec_t::load(data + i + w));
+                a2 = Vec_t::add(a2, Vec_t::load(data + i + 2 * w));
+                a3 = Vec_t::add(a3, Vec_t::load(data + i + 3 * w));
+            }
+
+            for (; i + w <= n; i += w)
+                a0 = Vec_t::add(a0, Vec_t::load(data + i));
+
+            T lanes[w];
+            Vec_t::to_array(Vec_t::add(Vec_t::add(a0, a1), Vec_t::add(a2, a3)), lanes);
+
+            T out = T(0);
+            for (size_t j = 0; j < w; ++j)
+                out += lanes[j];
+
+            for (; i < n; ++i)
+                out += data[i];
+
+            return out;
+        }
+
+        // assumes n > 0
+        template<typename Vec_t, bool IsMin, typename T = typename Vec_t::value_t>
+        T extremum_kernel(const T* data, size_t n)
+        {
+            constexpr size_t w = Vec_t::width;
+            auto select = [](auto a, auto b) {
+                if constexpr (IsMin)
+                    return Vec_t::min(a, b);
+                else
+                    return Vec_t::max(a, b);
+            };
+
+            auto a0 = Vec_t::broadcast(data[0]), a1 = a0;
+
+            size_t i = 0;
+            for (; i + 2 * w <= n; i += 2 * w)
+            {
+                a0 = select(a0, Vec_t::load(data + i));
+                a1 = select(a1, Vec_t::load(data + i + w));
+            }
+
+            for (; i + w <= n; i += w)
+                a0 = select(a0, Vec_t::load(data + i));
+
+            T lanes[w];
+            Vec_t::to_array(select(a0, a1), lanes);
+
+            auto select_scalar = [](T a, T b) {
+                if constexpr (IsMin)
+                    return ScalarTraits<T>::min(a, b);
+                else
+                    return ScalarTraits<T>::max(a, b);
+            };
+
+            T out = lanes[0];
+            for (size_t j = 1; j < w; ++j)
+                out = select_scalar(out, lanes[j]);
+
+            for (; i < n; ++i)
+                out = select_scalar(out, data[i]);
+
+            return out;
+        }
+
+        template<typename Vec_t, typename T = typename Vec_t::value_t>
+        T dot_kernel(const T* a, const T* b, size_t n)
+        {
+            constexpr size_t w = Vec_t::width;
+            auto a0 = Vec_t::zero(), a1 = Vec_t::zero(), a2 = Vec_t::zero(), a3 = Vec_t::zero();
+
+            size_t i = 0;
+            for (; i + 4 * w <= n; i += 4 * w)
+            {
+                a0 = Vec_t::fma(Vec_t::load(a + i), Vec_t::load(b + i), a0);
+                a1 = Vec_t::fma(Vec_t::load(a + i + w), Vec_t::load(b + i + w), a1);
+                a2 = Vec_t::fma(Vec_t::load(a + i + 2 * w), Vec_t::load(b + i + 2 * w), a2);
+                a3 = Vec_t::fma(Vec_t::load(a + i + 3 * w), Vec_t::load(b + i + 3 * w), a3);
+            }
+
+            for (; i + w <= n; i += w)
+                a0 = Vec_t::fma(Vec_t::load(a + i), Vec_t::load(b + i), a0);
+
+            T lanes[w];
+            Vec_t::to_array(Vec_t::add(Vec_t::add(a0, a1), Vec_t::add(a2, a3)), lanes);
+
+            T out = T(0);
+            for (size_t j = 0; j < w; ++j)
+                out += lanes[j];
+
+            for (; i < n; ++i)
+                out += a[i] * b[i];
+
+            return out;
+        }
+
+        template<typename Vec_t, typename T = typename Vec_t::value_t>
+        T sum_of_squares_kernel(const T* data, size_t n)
+        {
+            return dot_kernel<Vec_t>(data, data, n);
+        }
+
+        template<typename Vec_t, typename T = typename Vec_t::value_t>
+        void axpy_kernel(T alpha, const T* x, T* y, size_t n)
+        {
+            constexpr size_t w = Vec_t::width;
+            const auto alpha_v = Vec_t::broadcast(alpha);
+
+            size_t i = 0;
+            for (; i + w <= n; i += w)
+                Vec_t::store(y + i, Vec_t::fma(alpha_v, Vec_t::load(x + i), Vec_t::load(y + i)));
+
+            for (; i < n; ++i)
+                y[i] = alpha * x[i] + y[i];
+        }
+
+        // values outside [min, max) and NaN are ignored, counts has to have n_bins elements
+        template<typename Vec_t, typename T = typename Vec_t::value_t>
+        void histogram_kernel(const T* data, size_t n, T min, T max, size_t n_bins, size_t* counts)
+        {
+            constexpr size_t w = Vec_t::width;
+            const T scale = T(n_bins) / (max - min);
+            const int32_t last_bin = static_cast<int32_t>(n_bins - 1);
+
+            const auto min_v = Vec_t::broadcast(min);
+            const auto max_v = Vec_t::broadcast(max);
+            const auto scale_v = Vec_t::broadcast(scale);
+
+            int32_t bins[w];
+
+            // bin index can round up to n_bins for values just below max, so it is clamped
+            auto add = [&](int32_t bin) {
+                counts[bin < last_bin ? bin : last_bin] += 1;
+            };
+
+            size_t i = 0;
+            for (; i + w <= n; i += w)
+            {
+                uint32_t mask = Vec_t::bins(Vec_t::load(data + i), min_v, max_v, scale_v, bins);
+                for (size_t j = 0; j < w; ++j)
+                    if (mask & (uint32_t(1) << j))
+                        add(bins[j]);
+            }
+
+            for (; i < n; ++i)
+            {
+                int32_t bin;
+                if (ScalarTraits<T>::bins(data[i], min, max, scale, &bin))
+                    add(bin);
+            }
+        }
+
+        template<typename Vec_t, typename T = typename Vec_t::value_t>
+        KernelTable<T> make_kernel_table()
+        {
+            return KernelTable<T>{
+                &sum_kernel<Vec_t>,
+                &extremum_kernel<Vec_t, true>,
+                &extremum_kernel<Vec_t, false>,
+                &dot_kernel<Vec_t>,
+                &sum_of_squares_kernel<Vec_t>,
+                &axpy_kernel<Vec_t>,
+                &histogram_kernel<Vec_t>
+            };
+        }
+    }
+}
@@ -26,6 +26,125 @@ namespace jluna
         delete _lock;
     }
 
+    AssignmentBatch::AssignmentBatch(std::initializer_list<Entry> entries)
+        : _entries(entries)
+    {}
+
+    size_t AssignmentBatch::size() const
+    {
+        return _entries.size();
+    }
+
+    void AssignmentBatch::clear()
+    {
+        _entries.clear();
+    }
+
+    void Module::assign_many(const AssignmentBatch& batch)
+    {
+        apply(batch._entries, false);
+    }
+
+    void Module::assign_many(std::initializer_list<AssignmentBatch::Entry> entries)
+    {
+        apply(std::vector<AssignmentBatch::Entry>(entries), false);
+    }
+
+    void Module::create_or_assign_many(const AssignmentBatch& batch)
+    {
+        apply(batch._entries, true);
+    }
+
+    void Module::create_or_assign_many(std::initializer_list<AssignmentBatch::Entry> entries)
+    {
+        apply(std::vector<AssignmentBatch::Entry>(entries), true);
+    }
+
+    namespace detail
+    {
+        // throw the error jl_set_global would throw when assigning value to name: UndefVarError if it does not exist and create is false,
+        // ErrorException if it is a constant with a different value, TypeError if value does not match its declared type
+        static void assert_assignable(unsafe::Module* m, unsafe::Symbol* name, unsafe::Value* value, bool create)
+        {
+            auto name_str = std::string(jl_symbol_name(name));
+
+            if (not create and not jl_defines_or_exports_p(m, name))
+            {
+                JL_TRY
+                    jl_undefined_var_error(name);
+                JL_CATCH
+                    throw JuliaException((unsafe::Value*) jl_exception_occurred(), "in jluna::Module::assign_many: UndefVarError: " + name_str + " not defined");
+            }
+
+            if (jl_is_const(m, name) and not jl_egal(jl_get_global(m, name), value))
+            {
+                JL_TRY
+                    jl_errorf("invalid redefinition of constant %s", name_str.c_str());
+                JL_CATCH
+                    throw JuliaException((unsafe::Value*) jl_exception_occurred(), "in jluna::Module::assign_many: invalid redefinition of constant " + name_str);
+            }
+
+            // globals can only be typed since Julia 1.8, jl_get_binding_type returns jl_nothing if the binding does not exist yet
+            #if defined(JULIA_VERSION_MAJOR) and (JULIA_VERSION_MAJOR > 1 or (JULIA_VERSION_MAJOR == 1 and JULIA_VERSION_MINOR >= 9))
+                auto* type = jl_get_binding_type(m, name);
+                if (type != nullptr and type != jl_nothing and not jl_isa(value, type))
+                {
+                    JL_TRY
+                        jl_type_error("assign_many", type, value);
+                    JL_CATCH
+                        throw JuliaException((unsafe::Value*) jl_exception_occurred(), "in jluna::Module::assign_many: TypeError: value for " + name_str + " does not match its declared type");
+                }
+            #endif
+        }
+    }
+
+    void Module::apply(const std::vector<AssignmentBatch::Entry>& entries, bool create)
+    {
+        auto lock = acquire_lock();
+        unsafe::Module* me = value();
+
+        // box and check all values first, such that either all or none of the variables are assigned
+        std::vector<unsafe::Value*> values;
+        values.reserve(entries.size());
+
+        gc_pause;
+        try
+        {
+            for (auto& entry : entries)
+            {
+                values.push_back(entry._box());
+                detail::assert_assignable(me, entry._name, values.back(), create);
+            }
+        }
+        catch (...)
+        {
+            gc_unpause;
+            throw;
+        }
+
+        unsafe::Value* exception = nullptr;
+        JL_TRY
+        {
+            for (size_t i = 0; i < entries.size(); ++i)
+                jl_set_global(me, entries.at(i)._name, values.at(i));
+        }
+        JL_CATCH
+        {
+            exception = (unsafe::Value*) jl_exception_occurred();
+        }
+
+        if (exception != nullptr)
+        {
+            auto error = JuliaException(exception, "in jluna::Module::assign_many: assignment failed after all values were checked");
+            gc_unpause;
+            lock.unlock();
+
+            throw error;
+        }
+
+        gc_unpause;
+    }
+
     jl_module_t * Module::value() const
     {
         return (jl_module_t*) Proxy::operator const unsafe::Value*();
@@ -84,7 +203,17 @@ namespace jluna
 
     void Module::initialize_lock()
     {
+        // threads adopted through ThreadGuard may call this concurrently, even if Julia has only one thread
+        static std::mutex initialize_mutex;
+        std::lock_guard<std::mutex> guard(initialize_mutex);
+
         if (_lock == nullptr)
             _lock = new Mutex();
     }
+
+    std::unique_lock<Mutex> Module::acquire_lock()
+    {
+        initialize_lock();
+        return std::unique_lock<Mutex>(*_lock);
+    }
 }
@@ -29,17 +29,24 @@ namespace jluna
         static inline const std::string type_name = "Module";
     };
 
+    template<is_boxable T>
+    AssignmentBatch::Entry::Entry(const std::string& variable_name, T value)
+        : _name(jl_symbol(variable_name.c_str())), _box([value = std::move(value)]() -> unsafe::Value* { return box<T>(value); })
+    {}
+
+    template<is_boxable T>
+    AssignmentBatch& AssignmentBatch::add(const std::string& variable_name, T value)
+    {
+        _entries.emplace_back(variable_name, std::move(value));
+        return *this;
+    }
+
     template<is_boxable T>
     void Module::assign(const std::string& variable_name, T new_value)
     {
         static jl_function_t* assign_in_module = unsafe::get_function("jluna"_sym, "assign_in_module"_sym);
 
-        if (detail::_num_threads != 1)
-        {
-            initialize_lock();
-            _lock->lock();
-        }
-
+        auto lock = acquire_lock();
         unsafe::Module* me = value();
         auto* sym = jl_symbol(variable_name.c_str());
 
@@ -47,14 +54,14 @@ namespace jluna
             jl_set_global(value(), jl_symbol(variable_name.c_str()), box<T>(new_value));
         else
         {
+            // lock is not reentrant, release it before throwing
+            lock.unlock();
+
             JL_TRY
                 jl_undefined_var_error(sym);
             JL_CATCH
                 throw JuliaException((unsafe::Value*) jl_exception_occurred(), "in jluna::Module::assign: UndefVarError: " + variable_name + " not defined");
         }
-
-        if (detail::_num_threads != 1)
-            _lock->unlock();
     }
 
     template<is_boxable T>
@@ -62,16 +69,8 @@ namespace jluna
     {
         static jl_function_t* assign_in_module = unsafe::get_function("jluna"_sym, "create_or_assign_in_module"_sym);
 
-        if (detail::_num_threads != 1)
-        {
-            initialize_lock();
-            _lock->lock();
-        }
-
+        auto lock = acquire_lock();
         jl_set_global(value(), jl_symbol(variable_name.c_str()), box<T>(new_value));
-
-        if (detail::_num_threads != 1)
-            _lock->unlock();
     }
 
     inline Proxy Module::new_undef(const std::string& name)
@@ -275,10 +274,11 @@ namespace jluna
             (add(dims, ++i), ...);
         }
 
-        initialize_lock();
-        _lock->lock();
-        jluna::safe_eval(str.str());
-        _lock->unlock();
+        {
+            initialize_lock();
+            std::lock_guard<Mutex> lock(*_lock);
+            jluna::safe_eval(str.str());
+        }
         return Main[name];
     }
 
@@ -301,6 +301,86 @@ namespace jluna
         }
     }
 
+    template<is_unboxable T>
+    Binding<T> Module::binding(const std::string& variable_name)
+    {
+        auto* sym = jl_symbol(variable_name.c_str());
+        auto* me = value();
+
+        if (not jl_defines_or_exports_p(me, sym) or jl_get_global(me, sym) == nullptr)
+        {
+            JL_TRY
+                jl_undefined_var_error(sym);
+            JL_CATCH
+                throw JuliaException((unsafe::Value*) jl_exception_occurred(), "in jluna::Module::binding: UndefVarError: " + variable_name + " not defined");
+        }
+
+        return Binding<T>(me, sym);
+    }
+
+    template<is_unboxable T>
+    Binding<T>::Binding(unsafe::Module* module, unsafe::Symbol* name)
+        : _module(module), _name(name), _is_const(jl_is_const(module, name))
+    {
+        #ifdef JLUNA_DIRECT_BINDING_ACCESS
+            _binding = jl_get_binding(module, name);
+        #endif
+
+        if constexpr (is_native_function_type<T>)
+        {
+            _type = (unsafe::Value*) as_julia_type<T>::type();
+
+            #if defined(JLUNA_DIRECT_BINDING_ACCESS) and JULIA_VERSION_MINOR >= 9
+                // typed global, the type is checked once
+                _type_checked = (unsafe::Value*) _binding->ty == _type;
+            #endif
+        }
+    }
+
+    template<is_unboxable T>
+    T Binding<T>::get() const
+    {
+        #ifdef JLUNA_DIRECT_BINDING_ACCESS
+            auto* value = (unsafe::Value*) _binding->value;
+        #else
+            auto* value = jl_get_global(_module, _name);
+        #endif
+
+        if (value == nullptr)
+        {
+            JL_TRY
+                jl_undefined_var_error(_name);
+            JL_CATCH
+                throw JuliaException((unsafe::Value*) jl_exception_occurred(), "in jluna::Binding::get: UndefVarError: " + get_name() + " not defined");
+        }
+
+        if constexpr (is_native_function_type<T>)
+        {
+            if (_type_checked or jl_typeof(value) == _type)
+                return unsafe::unsafe_unbox<T>(value);
+        }
+
+        return unbox<T>(value);
+    }
+
+    template<is_unboxable T>
+    Binding<T>::operator T() const
+    {
+        return get();
+    }
+
+    template<is_unboxable T>
+    std::string Binding<T>::get_name() const
+    {
+        return jl_symbol_name(_name);
+    }
+
+    template<is_unboxable T>
+    bool Binding<T>::is_const() const
+    {
+        return _is_const;
+    }
+
     inline Proxy Module::get(const std::string& variable_name)
     {
         return Proxy(get<unsafe::Value*>(variable_name), jl_symbol(variable_name.c_str()));
@@ -15,7 +15,7 @@ namespace jluna
             ~TaskValue();
 
             void free() override;
-            void initialize(std::function<unsafe::Value*()>*);
+            void initialize(TaskCallable*, ThreadPoolKind);
 
             unsafe::Value* _value;
             size_t _value_id;
@@ -24,65 +24,537 @@ namespace jluna
         };
     }
 
+    namespace detail
+    {
+        template<typename Result_t>
+        struct TaskGroupValue
+        {
+            using Value_t = typename TaskGroup<Result_t>::Value_t;
+
+            TaskGroupValue(size_t n);
+            ~TaskGroupValue();
+
+            void wait_all(bool propagate);
+
+            size_t _n;
+            std::unique_ptr<TaskCallable[]> _callables;
+            std::unique_ptr<Future<Value_t>[]> _futures;
+
+            unsafe::Value* _tasks = nullptr;
+            size_t _tasks_id = 0;
+        };
+    }
+
+    namespace detail
+    {
+        inline TaskCallable::~TaskCallable()
+        {
+            reset();
+        }
+
+        template<typename Lambda_t>
+        void TaskCallable::emplace(Lambda_t&& lambda)
+        {
+            using Target_t = std::decay_t<Lambda_t>;
+            reset();
+
+            if constexpr (sizeof(Target_t) <= _buffer_size and alignof(Target_t) <= alignof(std::max_align_t))
+            {
+                _target = new (_buffer) Target_t(std::forward<Lambda_t>(lambda));
+                _destroy = [](void* target) {
+                    static_cast<Target_t*>(target)->~Target_t();
+                };
+            }
+            else
+            {
+                _target = new Target_t(std::forward<Lambda_t>(lambda));
+                _destroy = [](void* target) {
+                    delete static_cast<Target_t*>(target);
+                };
+            }
+
+            _invoke = [](void* target) -> unsafe::Value* {
+                return (*static_cast<Target_t*>(target))();
+            };
+        }
+
+        inline void TaskCallable::reset()
+        {
+            if (_target != nullptr)
+                _destroy(_target);
+
+            _target = nullptr;
+            _invoke = nullptr;
+            _destroy = nullptr;
+        }
+
+        inline unsafe::Value* TaskCallable::operator()()
+        {
+            return _invoke(_target);
+        }
+
+        inline size_t TaskSlotTable::allocate()
+        {
+            uint64_t head = _free_head.load(std::memory_order_acquire);
+            while (static_cast<uint32_t>(head) != 0)
+            {
+                size_t id = static_cast<uint32_t>(head) - 1;
+                uint64_t next = (((head >> 32) + 1) << 32) | at(id).next_free.load(std::memory_order_relaxed);
+
+                if (_free_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+                    return id;
+            }
+
+            size_t id = _n_used.fetch_add(1, std::memory_order_relaxed);
+            if (id >= _slab_size * _max_n_slabs)
+                throw std::length_error("In jluna::ThreadPool: more than " + std::to_string(_slab_size * _max_n_slabs) + " tasks exist at the same time");
+
+            auto& slab = _slabs[id / _slab_size];
+            if (slab.load(std::memory_order_acquire) == nullptr)
+            {
+                auto* fresh = new TaskSlot[_slab_size];
+                TaskSlot* expected = nullptr;
+                if (not slab.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+                    delete[] fresh;
+            }
+
+            return id;
+        }
+
+        inline void TaskSlotTable::free(size_t id)
+        {
+            uint64_t head = _free_head.load(std::memory_order_relaxed);
+            uint64_t next;
+            do
+            {
+                at(id).next_free.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+                next = (((head >> 32) + 1) << 32) | (id + 1);
+            }
+            while (not _free_head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        inline TaskSlot& TaskSlotTable::at(size_t id)
+        {
+            return _slabs[id / _slab_size].load(std::memory_order_acquire)[id % _slab_size];
+        }
+    }
+
+    namespace detail
+    {
+        template<typename T>
+        struct FutureState
+        {
+            std::mutex _mutex;
+            std::condition_variable _cv;
+            std::unique_ptr<T> _value;
+            bool _failed = false;
+
+            // invoked once, from the thread that sets the value, after the value became available
+            std::vector<std::function<void()>> _callbacks;
+
+            bool is_ready() const
+            {
+                return _value != nullptr or _failed;
+            }
+        };
+    }
+
     template<typename T>
     Future<T>::Future()
-        : _mutex(), _cv_lock(), _cv()
+        : _state(std::make_shared<detail::FutureState<T>>())
     {}
 
     template<typename T>
     std::optional<T> Future<T>::get()
     {
         std::optional<T> out;
-        _mutex.lock();
-        if (_value != nullptr)
-            out = std::optional<T>(*(_value.get()));
-        _mutex.unlock();
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+        if (_state->_value != nullptr and not _state->_failed)
+            out = std::optional<T>(*(_state->_value.get()));
         return out;
     }
 
     template<typename T>
     bool Future<T>::is_available()
     {
-        bool out = false;
-        _mutex.lock();
-        if (_value != nullptr)
-            out = true;
-        _mutex.unlock();
-        return out;
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+        return _state->_value != nullptr and not _state->_failed;
+    }
+
+    template<typename T>
+    bool Future<T>::is_failed()
+    {
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+        return _state->_failed;
     }
 
     template<typename T>
     std::optional<T> Future<T>::wait()
     {
-        _cv.wait(_cv_lock, [&](){
-            return _value.get() != nullptr;
+        std::unique_lock<std::mutex> lock(_state->_mutex);
+        _state->_cv.wait(lock, [&](){
+            return _state->is_ready();
         });
-        return get();
+
+        if (_state->_value != nullptr and not _state->_failed)
+            return std::optional<T>(*(_state->_value.get()));
+        else
+            return std::nullopt;
     }
 
     namespace detail
     {
         struct FutureHandler
         {
+            // set value, then return a reference to the stored value, which stays valid as long as the future does
+            template<typename T>
+            static inline const T& update_future(Future<T>& future, T&& value)
+            {
+                future.set_value(std::move(value));
+                return *(future._state->_value.get());
+            }
+
+            template<typename T>
+            static inline void fail_future(Future<T>& future)
+            {
+                future.set_failed();
+            }
+
+            // invoke f once the future is available or failed, if it already is, f is invoked immediately
             template<typename T>
-            static inline void update_future(Future<T>& future, T value)
+            static inline void on_ready(Future<T>& future, std::function<void()> f)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(future._state->_mutex);
+                    if (not future._state->is_ready())
+                    {
+                        future._state->_callbacks.push_back(std::move(f));
+                        return;
+                    }
+                }
+
+                f();
+            }
+
+            // get pointer to value, nullptr if the future failed. Only valid once the future is ready
+            template<typename T>
+            static inline const T* get_value(const Future<T>& future)
+            {
+                if (future._state->_failed)
+                    return nullptr;
+
+                return future._state->_value.get();
+            }
+
+            // invoke a C++-side function in a new Julia-side task that is not tracked by the threadpool, the callable is deleted after invocation
+            static inline void spawn_detached(TaskCallable* callable)
+            {
+                static auto* spawn_detached = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "spawn_detached"_sym);
+                jluna::safe_call(spawn_detached, jl_box_uint64(reinterpret_cast<size_t>(callable)));
+            }
+        };
+    }
+
+    template<typename T>
+    void Future<T>::set_value(T&& value)
+    {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(_state->_mutex);
+            _state->_value = std::make_unique<T>(std::move(value));
+
+            // failed through cancellation, the value is stored but never observed
+            if (_state->_failed)
+                return;
+
+            callbacks.swap(_state->_callbacks);
+        }
+
+        _state->_cv.notify_all();
+        for (auto& f : callbacks)
+            f();
+    }
+
+    template<typename T>
+    void Future<T>::set_failed()
+    {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(_state->_mutex);
+            if (_state->is_ready())
+                return;
+
+            _state->_failed = true;
+            callbacks.swap(_state->_callbacks);
+        }
+
+        _state->_cv.notify_all();
+        for (auto& f : callbacks)
+            f();
+    }
+
+    template<typename T>
+    template<typename Function_t, typename Result_t>
+    Future<detail::as_future_value_t<Result_t>> Future<T>::then(Function_t f)
+    {
+        using Next_t = detail::as_future_value_t<Result_t>;
+
+        // if the value is already available, the continuation is spawned from this thread
+        if (jl_get_pgcstack() == nullptr)
+            throw std::runtime_error("In jluna::Future::then: registering a continuation requires the current thread to be a Julia thread, construct a jluna::ThreadGuard in C++-side threads first");
+
+        auto next = Future<Next_t>();
+        detail::FutureHandler::on_ready(*this, [self = *this, next, f]() mutable {
+
+            auto* callable = new detail::TaskCallable();
+            callable->emplace([self, next, f]() mutable -> unsafe::Value* {
+
+                const T* value = detail::FutureHandler::get_value(self);
+                if (value == nullptr)
+                {
+                    detail::FutureHandler::fail_future(next);
+                    return jl_nothing;
+                }
+
+                try
+                {
+                    if constexpr (std::is_void_v<Result_t>)
+                    {
+                        f(*value);
+                        detail::FutureHandler::update_future<Next_t>(next, (unsafe::Value*) jl_nothing);
+                    }
+                    else
+                        detail::FutureHandler::update_future<Next_t>(next, f(*value));
+                }
+                catch (...)
+                {
+                    detail::FutureHandler::fail_future(next);
+                }
+
+                return jl_nothing;
+            });
+
+            detail::FutureHandler::spawn_detached(callable);
+        });
+
+        return next;
+    }
+
+    template<typename... Ts>
+    Future<std::tuple<Ts...>> when_all(Future<Ts>... futures)
+    {
+        auto out = Future<std::tuple<Ts...>>();
+
+        if constexpr (sizeof...(Ts) == 0)
+        {
+            detail::FutureHandler::update_future<std::tuple<>>(out, std::tuple<>());
+            return out;
+        }
+        else
+        {
+            auto n_remaining = std::make_shared<std::atomic<size_t>>(sizeof...(Ts));
+            auto on_ready = [out, n_remaining, futures...]() mutable {
+
+                if (n_remaining->fetch_sub(1) != 1)
+                    return;
+
+                if (((detail::FutureHandler::get_value(futures) == nullptr) or ...))
+                    detail::FutureHandler::fail_future(out);
+                else
+                    detail::FutureHandler::update_future<std::tuple<Ts...>>(out, std::tuple<Ts...>(*detail::FutureHandler::get_value(futures)...));
+            };
+
+            (detail::FutureHandler::on_ready(futures, on_ready), ...);
+            return out;
+        }
+    }
+
+    template<typename T>
+    Future<std::vector<T>> when_all(const std::vector<Future<T>>& futures)
+    {
+        auto out = Future<std::vector<T>>();
+
+        if (futures.empty())
+        {
+            detail::FutureHandler::update_future<std::vector<T>>(out, std::vector<T>());
+            return out;
+        }
+
+        auto n_remaining = std::make_shared<std::atomic<size_t>>(futures.size());
+        auto on_ready = [out, n_remaining, futures]() mutable {
+
+            if (n_remaining->fetch_sub(1) != 1)
+                return;
+
+            std::vector<T> values;
+            values.reserve(futures.size());
+
+            for (auto& future : futures)
             {
-                future.set_value(value);
+                const T* value = detail::FutureHandler::get_value(future);
+                if (value == nullptr)
+                {
+                    detail::FutureHandler::fail_future(out);
+                    return;
+                }
+
+                values.push_back(*value);
             }
+
+            detail::FutureHandler::update_future<std::vector<T>>(out, std::move(values));
         };
+
+        for (auto future : futures)
+            detail::FutureHandler::on_ready(future, on_ready);
+
+        return out;
     }
 
     template<typename T>
-    void Future<T>::set_value(T value)
+    Future<std::pair<size_t, T>> when_any(const std::vector<Future<T>>& futures)
     {
-        _mutex.lock();
-        _value = std::make_unique<T>(value);
-        _cv.notify_all();
-        _mutex.unlock();
+        if (futures.empty())
+            throw std::invalid_argument("In jluna::when_any: at least one future has to be specified");
+
+        auto out = Future<std::pair<size_t, T>>();
+
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        auto n_failed = std::make_shared<std::atomic<size_t>>(0);
+        const size_t n = futures.size();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto future = futures.at(i);
+            detail::FutureHandler::on_ready(future, [out, done, n_failed, n, i, future]() mutable {
+
+                const T* value = detail::FutureHandler::get_value(future);
+                if (value != nullptr)
+                {
+                    if (not done->exchange(true))
+                        detail::FutureHandler::update_future<std::pair<size_t, T>>(out, std::pair<size_t, T>(i, *value));
+                }
+                else if (n_failed->fetch_add(1) + 1 == n)
+                    detail::FutureHandler::fail_future(out);
+            });
+        }
+
+        return out;
+    }
+
+    template<typename T, typename... Ts> requires (std::is_same_v<T, Ts> and ...)
+    Future<std::pair<size_t, T>> when_any(Future<T> first, Future<Ts>... rest)
+    {
+        return when_any(std::vector<Future<T>>{first, rest...});
     }
 
     // ###
 
+    namespace detail
+    {
+        // counters of tasks created through ThreadPool::create, indexed by ThreadPoolKind
+        struct TaskPoolCounters
+        {
+            std::atomic<size_t> n_queued = 0;
+            std::atomic<size_t> n_running = 0;
+        };
+
+        inline std::array<TaskPoolCounters, 2> _task_pool_counters = {};
+
+        inline TaskPoolCounters& get_pool_counters(ThreadPoolKind pool)
+        {
+            return _task_pool_counters.at(static_cast<size_t>(pool));
+        }
+
+        inline unsafe::Symbol* get_pool_symbol(ThreadPoolKind pool)
+        {
+            static auto* default_symbol = jl_symbol("default");
+            static auto* interactive_symbol = jl_symbol("interactive");
+            return pool == ThreadPoolKind::INTERACTIVE ? interactive_symbol : default_symbol;
+        }
+
+        // pool a task created for `pool` actually runs in, make_task falls back to the default pool if the interactive pool has no threads
+        inline ThreadPoolKind resolve_pool(ThreadPoolKind pool)
+        {
+            static const bool has_interactive_threads = ThreadPool::n_threads(ThreadPoolKind::INTERACTIVE) > 0;
+            return (pool == ThreadPoolKind::INTERACTIVE and not has_interactive_threads) ? ThreadPoolKind::DEFAULT : pool;
+        }
+
+        // created -> queued, called by Task::schedule
+        inline void on_task_scheduled(TaskSuper* task)
+        {
+            uint8_t expected = 0;
+            if (task->_stage.compare_exchange_strong(expected, 1))
+                get_pool_counters(task->_pool).n_queued.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // queued -> done, called by Task::cancel. Has no effect if the task already started
+        inline void on_task_cancelled(TaskSuper* task)
+        {
+            uint8_t expected = 1;
+            if (task->_stage.compare_exchange_strong(expected, 3))
+                get_pool_counters(task->_pool).n_queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // marks the task as running while the C++-side function executes
+        class TaskRunningScope
+        {
+            public:
+                TaskRunningScope(TaskSuper* task)
+                    : _task(task)
+                {
+                    auto& counters = get_pool_counters(_task->_pool);
+                    if (_task->_stage.exchange(2) == 1)
+                        counters.n_queued.fetch_sub(1, std::memory_order_relaxed);
+
+                    counters.n_running.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                ~TaskRunningScope()
+                {
+                    _task->_stage.store(3);
+                    get_pool_counters(_task->_pool).n_running.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+            private:
+                TaskSuper* _task;
+        };
+
+        // invoke f, then publish its result to future, or fail the future if f threw. A waiter may free the task, including the callable
+        // this is invoked from, as soon as the future is ready, so publishing is the last step that touches either of them
+        // task may be nullptr, in which case it is not marked as running
+        template<typename T, typename Function_t>
+        unsafe::Value* invoke_and_publish(TaskSuper* task, Future<as_future_value_t<T>> future, Function_t& f)
+        {
+            std::optional<TaskRunningScope> scope;
+            if (task != nullptr)
+                scope.emplace(task);
+
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    f();
+                    scope.reset();
+                    FutureHandler::update_future<unsafe::Value*>(future, (unsafe::Value*) jl_nothing);
+                    return jl_nothing;
+                }
+                else
+                {
+                    T value = f();
+                    scope.reset();
+                    FutureHandler::update_future<T>(future, T(value));
+                    return box<T>(value);
+                }
+            }
+            catch (...)
+            {
+                scope.reset();
+                FutureHandler::fail_future(future);
+                return jl_nothing;
+            }
+        }
+    }
+
     template<typename T>
     detail::TaskValue<T>::TaskValue(size_t id)
         : _threadpool_id(id), _future(std::make_unique<Future<T>>())
@@ -99,16 +571,12 @@ namespace jluna
     {}
 
     template<typename T>
-    void detail::TaskValue<T>::initialize(std::function<unsafe::Value*()>* in)
+    void detail::TaskValue<T>::initialize(TaskCallable* in, ThreadPoolKind pool)
     {
         static auto* make_task = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_task"_sym);
-        _value = unsafe::call(make_task, box(reinterpret_cast<size_t>(in)));
-
-        static auto* setfield = unsafe::get_function(jl_base_module, "setfield!"_sym);
-        static auto* sticky = jl_symbol("sticky");
-
-        unsafe::call(setfield, _value, sticky, jl_box_bool(false));
 
+        _pool = detail::resolve_pool(pool);
+        _value = unsafe::call(make_task, box(reinterpret_cast<size_t>(in)), (unsafe::Value*) detail::get_pool_symbol(_pool));
         _value_id = unsafe::gc_preserve(_value);
     }
 
@@ -164,9 +632,26 @@ namespace jluna
             return;
 
         static auto* schedule = unsafe::get_function(jl_base_module, "schedule"_sym);
+        detail::on_task_scheduled(_value);
         jluna::safe_call(schedule, _value->_value);
     }
 
+    template<typename T>
+    bool Task<T>::cancel()
+    {
+        if (_value == nullptr)
+            return false;
+
+        static auto* cancel_task = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "cancel_task"_sym);
+        if (not jl_unbox_bool(jluna::safe_call(cancel_task, _value->_value)))
+            return false;
+
+        // has no effect if the value already became available
+        detail::on_task_cancelled(_value);
+        detail::FutureHandler::fail_future(*(_value->_future.get()));
+        return true;
+    }
+
     template<typename T>
     bool Task<T>::is_done() const
     {
@@ -226,6 +711,7 @@ namespace jluna
             operator unsafe::Value*();
             void join();
             void schedule();
+            bool cancel();
             bool is_done() const;
             bool is_failed() const;
             bool is_running() const;
@@ -283,9 +769,25 @@ namespace jluna
             return;
 
         static auto* schedule = unsafe::get_function(jl_base_module, "schedule"_sym);
+        detail::on_task_scheduled(_value);
         jluna::safe_call(schedule, _value->_value);
     }
 
+    inline bool Task<void>::cancel()
+    {
+        if (_value == nullptr)
+            return false;
+
+        static auto* cancel_task = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "cancel_task"_sym);
+        if (not jl_unbox_bool(jluna::safe_call(cancel_task, _value->_value)))
+            return false;
+
+        // has no effect if the value already became available
+        detail::on_task_cancelled(_value);
+        detail::FutureHandler::fail_future(*(_value->_future.get()));
+        return true;
+    }
+
     inline bool Task<void>::is_done() const
     {
         if (_value == nullptr)
@@ -325,62 +827,222 @@ namespace jluna
 
     // ###
 
+    template<typename T>
+    detail::TaskGroupValue<T>::TaskGroupValue(size_t n)
+        : _n(n), _callables(new TaskCallable[n]), _futures(new Future<Value_t>[n])
+    {}
+
+    template<typename T>
+    detail::TaskGroupValue<T>::~TaskGroupValue()
+    {
+        // callables have to outlive the tasks invoking them
+        wait_all(false);
+
+        if (_tasks != nullptr)
+            unsafe::gc_release(_tasks_id);
+    }
+
+    template<typename T>
+    void detail::TaskGroupValue<T>::wait_all(bool propagate)
+    {
+        if (_tasks == nullptr)
+            return;
+
+        static auto* wait_all = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "wait_all"_sym);
+
+        if (propagate)
+            jluna::safe_call(wait_all, _tasks, jl_box_bool(true));
+        else
+            unsafe::call(wait_all, _tasks, jl_box_bool(false));
+    }
+
+    template<typename T>
+    TaskGroup<T>::TaskGroup(std::unique_ptr<detail::TaskGroupValue<T>> value)
+        : _value(std::move(value))
+    {}
+
+    template<typename T>
+    TaskGroup<T>::~TaskGroup()
+    {}
+
+    template<typename T>
+    TaskGroup<T>::TaskGroup(TaskGroup&& other)
+        : _value(std::move(other._value))
+    {}
+
+    template<typename T>
+    TaskGroup<T>& TaskGroup<T>::operator=(TaskGroup&& other)
+    {
+        _value = std::move(other._value);
+        return *this;
+    }
+
+    template<typename T>
+    TaskGroup<T>::operator unsafe::Value*()
+    {
+        if (_value == nullptr or _value->_tasks == nullptr)
+            return jl_nothing;
+        else
+            return _value->_tasks;
+    }
+
+    template<typename T>
+    void TaskGroup<T>::wait_all()
+    {
+        if (_value != nullptr)
+            _value->wait_all(true);
+    }
+
+    template<typename T>
+    bool TaskGroup<T>::is_done() const
+    {
+        if (_value == nullptr)
+            return false;
+
+        for (size_t i = 0; i < _value->_n; ++i)
+            if (not _value->_futures[i].is_available())
+                return false;
+
+        return true;
+    }
+
+    template<typename T>
+    size_t TaskGroup<T>::size() const
+    {
+        if (_value == nullptr)
+            return 0;
+
+        return _value->_n;
+    }
+
+    template<typename T>
+    Future<typename TaskGroup<T>::Value_t>& TaskGroup<T>::result(size_t i)
+    {
+        if (i >= size())
+        {
+            std::stringstream str;
+            str << "In TaskGroup::result: index " << i << " is out of range for a group of " << size() << " tasks" << std::endl;
+            throw std::out_of_range(str.str());
+        }
+
+        return _value->_futures[i];
+    }
+
+    // ###
+
     template<typename Signature, typename Lambda_t, typename... Args_t, typename T>
     Task<T> ThreadPool::create(Lambda_t f, Args_t... args)
     {
-        return ThreadPool::create(std::function<Signature>(f), args...);
+        return ThreadPool::create(ThreadPoolKind::DEFAULT, std::function<Signature>(f), args...);
     }
 
     template<typename... Args_t>
     Task<void> ThreadPool::create(const std::function<void(Args_t...)>& lambda, Args_t... args)
     {
-        _storage_lock.lock();
+        return ThreadPool::create(ThreadPoolKind::DEFAULT, lambda, args...);
+    }
 
-        detail::TaskValue<unsafe::Value*>* task = new detail::TaskValue<unsafe::Value*>(_current_id);
-        _storage.emplace(_current_id,
-            std::make_pair(
-            task,
-            std::make_unique<std::function<unsafe::Value*()>>([lambda, task, future = std::ref(*(task->_future.get())) ,args...]() -> unsafe::Value* {
-                lambda(args...);
-                detail::FutureHandler::update_future<unsafe::Value*>(future, jl_nothing);
-                return jl_nothing;
-        })));
-        auto& it = _storage.find(_current_id)->second;
-        task->initialize(it.second.get());
+    template<is_not<void> Return_t, typename... Args_t>
+    Task<Return_t> ThreadPool::create(const std::function<Return_t(Args_t...)>& lambda, Args_t... args)
+    {
+        return ThreadPool::create(ThreadPoolKind::DEFAULT, lambda, args...);
+    }
+
+    template<typename Signature, typename Lambda_t, typename... Args_t, typename T>
+    Task<T> ThreadPool::create(ThreadPoolKind pool, Lambda_t f, Args_t... args)
+    {
+        return ThreadPool::create(pool, std::function<Signature>(f), args...);
+    }
+
+    template<typename... Args_t>
+    Task<void> ThreadPool::create(ThreadPoolKind pool, const std::function<void(Args_t...)>& lambda, Args_t... args)
+    {
+        auto id = _slots.allocate();
+        auto& slot = _slots.at(id);
+
+        detail::TaskValue<unsafe::Value*>* task = new detail::TaskValue<unsafe::Value*>(id);
+        slot.task = task;
+        slot.callable.emplace([lambda, task, future = std::ref(*(task->_future.get())), args...]() -> unsafe::Value* {
+            auto f = [&]() { lambda(args...); };
+            return detail::invoke_and_publish<void>(task, future.get(), f);
+        });
+        task->initialize(&slot.callable, pool);
 
-        _current_id += 1;
-        _storage_lock.unlock();
         return Task<void>(task);
     }
 
     template<is_not<void> Return_t, typename... Args_t>
-    Task<Return_t> ThreadPool::create(const std::function<Return_t(Args_t...)>& lambda, Args_t... args)
+    Task<Return_t> ThreadPool::create(ThreadPoolKind pool, const std::function<Return_t(Args_t...)>& lambda, Args_t... args)
     {
-        _storage_lock.lock();
-
-        detail::TaskValue<Return_t>* task = new detail::TaskValue<Return_t>(_current_id);
-        _storage.emplace(_current_id,
-            std::make_pair(
-            task,
-            std::make_unique<std::function<unsafe::Value*()>>([lambda, future = std::ref(*(task->_future.get())) ,args...]() -> unsafe::Value* {
-                auto res = lambda(args...);
-                detail::FutureHandler::update_future<Return_t>(future, res);
-                return box<Return_t>(res);
-        })));
-        auto& it = _storage.find(_current_id)->second;
-        task->initialize(it.second.get());
-
-        _current_id += 1;
-        _storage_lock.unlock();
+        auto id = _slots.allocate();
+        auto& slot = _slots.at(id);
+
+        detail::TaskValue<Return_t>* task = new detail::TaskValue<Return_t>(id);
+        slot.task = task;
+        slot.callable.emplace([lambda, task, future = std::ref(*(task->_future.get())), args...]() -> unsafe::Value* {
+            auto f = [&]() -> Return_t { return lambda(args...); };
+            return detail::invoke_and_publish<Return_t>(task, future.get(), f);
+        });
+        task->initialize(&slot.callable, pool);
+
         return Task<Return_t>(task);
     }
 
+    template<Iterable Range_t, typename T>
+    TaskGroup<T> ThreadPool::spawn_batch(const Range_t& callables)
+    {
+        auto group = std::make_unique<detail::TaskGroupValue<T>>(std::distance(callables.begin(), callables.end()));
+
+        size_t i = 0;
+        for (const auto& f : callables)
+        {
+            auto& future = group->_futures[i];
+            group->_callables[i].emplace([f, future = std::ref(future)]() mutable -> unsafe::Value* {
+                return detail::invoke_and_publish<T>(nullptr, future.get(), f);
+            });
+            i += 1;
+        }
+
+        if (group->_n == 0)
+            return TaskGroup<T>(std::move(group));
+
+        static auto* spawn_batch = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "spawn_batch"_sym);
+
+        gc_pause;
+        group->_tasks = jluna::safe_call(spawn_batch,
+            jl_box_uint64(reinterpret_cast<size_t>(group->_callables.get())),
+            jl_box_uint64(sizeof(detail::TaskCallable)),
+            jl_box_uint64(group->_n)
+        );
+        group->_tasks_id = unsafe::gc_preserve(group->_tasks);
+        gc_unpause;
+
+        return TaskGroup<T>(std::move(group));
+    }
+
     inline size_t ThreadPool::n_threads()
     {
         static auto* nthreads = unsafe::get_function("Threads"_sym, "nthreads"_sym);
         return unbox<Int64>(jl_call0(nthreads));
     }
 
+    inline size_t ThreadPool::n_threads(ThreadPoolKind pool)
+    {
+        static auto* n_threads_in_pool = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "n_threads_in_pool"_sym);
+        return unbox<Int64>(jluna::safe_call(n_threads_in_pool, detail::get_pool_symbol(pool)));
+    }
+
+    inline ThreadPoolStats ThreadPool::get_stats(ThreadPoolKind pool)
+    {
+        const auto& counters = detail::get_pool_counters(pool);
+
+        ThreadPoolStats out;
+        out.n_threads = n_threads(pool);
+        out.n_queued = counters.n_queued.load();
+        out.n_running = counters.n_running.load();
+        return out;
+    }
+
     inline size_t ThreadPool::thread_id()
     {
         static auto* threadid = unsafe::get_function("Threads"_sym, "threadid"_sym);
@@ -389,13 +1051,12 @@ namespace jluna
 
     inline void ThreadPool::free(size_t id)
     {
-        _storage_lock.lock();
-        auto it = _storage.find(id);
-        auto* ptr = it->second.first;
-        ptr->free();
-        delete it->second.first;
-        _storage.erase(id);
-        _storage_lock.unlock();
+        auto& slot = _slots.at(id);
+        slot.task->free();
+        delete slot.task;
+        slot.task = nullptr;
+        slot.callable.reset();
+        _slots.free(id);
     }
 
     // ###
@@ -407,4 +1068,142 @@ namespace jluna
     }
 
     // ###
+
+    namespace detail
+    {
+        // execute worker n_workers times, each in its own Julia-side task, blocks until all are done
+        inline void run_workers(TaskCallable& worker, size_t n_workers)
+        {
+            if (n_workers == 0)
+                return;
+
+            if (n_workers == 1)
+            {
+                worker();
+                return;
+            }
+
+            static auto* run_workers = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "run_workers"_sym);
+            jluna::safe_call(run_workers, jl_box_uint64(reinterpret_cast<size_t>(&worker)), jl_box_uint64(n_workers));
+        }
+
+        // choose grain such that each thread claims roughly 8 chunks
+        inline size_t get_grain(IndexRange range, size_t grain, size_t n_threads)
+        {
+            if (grain != 0)
+                return grain;
+
+            return std::max<size_t>(1, (range.last - range.first) / (8 * n_threads));
+        }
+
+        // claim chunks from cursor until range is exhausted, invoke f on each
+        template<typename Chunk_t>
+        void process_chunks(std::atomic<size_t>& cursor, IndexRange range, size_t grain, std::atomic<bool>& abort, Chunk_t&& f)
+        {
+            while (not abort.load(std::memory_order_relaxed))
+            {
+                size_t first = cursor.fetch_add(grain, std::memory_order_relaxed);
+                if (first >= range.last)
+                    return;
+
+                f(first, std::min(first + grain, range.last));
+            }
+        }
+    }
+
+    template<typename Function_t>
+    void parallel_for(IndexRange range, size_t grain, Function_t f)
+    {
+        if (range.first >= range.last)
+            return;
+
+        const size_t n_threads = ThreadPool::n_threads();
+        grain = detail::get_grain(range, grain, n_threads);
+        const size_t n_chunks = (range.last - range.first + grain - 1) / grain;
+
+        std::atomic<size_t> cursor = range.first;
+        std::atomic<bool> abort = false;
+        std::mutex exception_lock;
+        std::exception_ptr exception = nullptr;
+
+        detail::TaskCallable worker;
+        worker.emplace([&]() -> unsafe::Value* {
+            try
+            {
+                detail::process_chunks(cursor, range, grain, abort, [&](size_t first, size_t last){
+                    if constexpr (std::is_invocable_v<Function_t, size_t, size_t>)
+                        f(first, last);
+                    else
+                        for (size_t i = first; i < last; ++i)
+                            f(i);
+                });
+            }
+            catch (...)
+            {
+                auto lock = std::lock_guard(exception_lock);
+                if (exception == nullptr)
+                    exception = std::current_exception();
+
+                abort = true;
+            }
+            return jl_nothing;
+        });
+
+        detail::run_workers(worker, std::min(n_threads, n_chunks));
+
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+    }
+
+    template<typename Result_t, typename Function_t, typename Combine_t>
+    Result_t parallel_reduce(IndexRange range, Result_t identity, Function_t f, Combine_t combine, size_t grain)
+    {
+        if (range.first >= range.last)
+            return identity;
+
+        const size_t n_threads = ThreadPool::n_threads();
+        grain = detail::get_grain(range, grain, n_threads);
+        const size_t n_chunks = (range.last - range.first + grain - 1) / grain;
+        const size_t n_workers = std::min(n_threads, n_chunks);
+
+        std::atomic<size_t> cursor = range.first;
+        std::atomic<size_t> worker_id = 0;
+        std::atomic<bool> abort = false;
+        std::mutex exception_lock;
+        std::exception_ptr exception = nullptr;
+
+        std::vector<Result_t> accumulators(n_workers, identity);
+
+        detail::TaskCallable worker;
+        worker.emplace([&]() -> unsafe::Value* {
+            try
+            {
+                Result_t& accumulator = accumulators.at(worker_id.fetch_add(1));
+                detail::process_chunks(cursor, range, grain, abort, [&](size_t first, size_t last){
+                    for (size_t i = first; i < last; ++i)
+                        accumulator = f(std::move(accumulator), i);
+                });
+            }
+            catch (...)
+            {
+                auto lock = std::lock_guard(exception_lock);
+                if (exception == nullptr)
+                    exception = std::current_exception();
+
+                abort = true;
+            }
+            return jl_nothing;
+        });
+
+        detail::run_workers(worker, n_workers);
+
+        if (exception != nullptr)
+            std::rethrow_exception(exception);
+
+        Result_t out = std::move(accumulators.front());
+        for (size_t i = 1; i < accumulators.size(); ++i)
+            out = combine(std::move(out), std::move(accumulators.at(i)));
+
+        return out;
+    }
 }
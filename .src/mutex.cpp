@@ -5,21 +5,87 @@
 
 #include <include/typedefs.hpp>
 #include <include/unsafe_utilities.hpp>
+#include <include/safe_utilities.hpp>
 #include <include/mutex.hpp>
 
+#include <thread>
+
 namespace jluna
 {
+    namespace detail
+    {
+        // number of attempts before a waiting thread parks
+        constexpr size_t _mutex_n_spins = 128;
+
+        static void cpu_pause()
+        {
+            #if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+                __builtin_ia32_pause();
+            #endif
+        }
+
+        // Julia threads have to yield to the Julia scheduler, as the task holding the lock may run on the same thread
+        static void yield_to_julia()
+        {
+            static auto* yield = unsafe::get_function(jl_base_module, "yield"_sym);
+            jluna::safe_call(yield);
+        }
+
+        // wait until word no longer holds value old, may return spuriously
+        template<typename Atomic_t>
+        static void park(Atomic_t& word, uint32_t old)
+        {
+            if (jl_get_pgcstack() != nullptr)
+                yield_to_julia();
+            else
+                word.wait(old, std::memory_order_relaxed);
+        }
+
+        // used while polling for a lock with a timeout
+        static void backoff(size_t n_attempts)
+        {
+            if (n_attempts < _mutex_n_spins)
+                cpu_pause();
+            else if (jl_get_pgcstack() != nullptr)
+                yield_to_julia();
+            else
+                std::this_thread::yield();
+        }
+    }
+
     Mutex::Mutex()
     {
         static auto* new_lock = unsafe::get_function("jluna"_sym, "new_lock"_sym);
         _value = unsafe::call(new_lock);
         _value_id = unsafe::gc_preserve(_value);
+
+        // jluna.Mutex._state is a Threads.Atomic{UInt32}, whose only field is the word itself
+        _state = reinterpret_cast<uint32_t*>(jl_get_nth_field(_value, 0));
     }
 
     Mutex::Mutex(unsafe::Value* lock)
     {
         _value = lock;
         _value_id = unsafe::gc_preserve(_value);
+        _state = reinterpret_cast<uint32_t*>(jl_get_nth_field(_value, 0));
+    }
+
+    Mutex::Mutex(const Mutex& other)
+        : Mutex(other._value)
+    {}
+
+    Mutex& Mutex::operator=(const Mutex& other)
+    {
+        if (&other == this)
+            return *this;
+
+        auto id = unsafe::gc_preserve(other._value);
+        unsafe::gc_release(_value_id);
+
+        _value = other._value;
+        _value_id = id;
+        _state = other._state;
+        return *this;
     }
 
     Mutex::~Mutex()
@@ -34,26 +100,154 @@ namespace jluna
 
     void Mutex::lock()
     {
-        static auto* lock = unsafe::get_function(jl_base_module, "lock"_sym);
-        unsafe::call(lock, _value);
+        auto state = std::atomic_ref<uint32_t>(*_state);
+
+        uint32_t expected = 0;
+        if (state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return;
+
+        for (size_t i = 0; i < detail::_mutex_n_spins; ++i)
+        {
+            detail::cpu_pause();
+
+            expected = 0;
+            if (state.load(std::memory_order_relaxed) == 0 and state.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+        }
+
+        // mark as contended, such that unlock wakes up parked threads
+        while (state.exchange(2, std::memory_order_acquire) != 0)
+            detail::park(state, 2);
     }
 
-    void Mutex::try_lock()
+    bool Mutex::try_lock()
     {
-        static auto* trylock = unsafe::get_function(jl_base_module, "trylock"_sym);
-        unsafe::call(trylock, _value);
+        auto state = std::atomic_ref<uint32_t>(*_state);
+        uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    bool Mutex::try_lock_for(std::chrono::nanoseconds timeout)
+    {
+        auto state = std::atomic_ref<uint32_t>(*_state);
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (size_t i = 0; true; ++i)
+        {
+            uint32_t expected = 0;
+            if (state.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+
+            detail::backoff(i);
+        }
     }
 
     void Mutex::unlock()
     {
-        static auto* unlock = unsafe::get_function(jl_base_module, "unlock"_sym);
-        unsafe::call(unlock, _value);
+        auto state = std::atomic_ref<uint32_t>(*_state);
+        if (state.exchange(0, std::memory_order_release) == 2)
+            state.notify_all();
     }
 
     bool Mutex::is_locked() const
     {
-        static auto* islocked = unsafe::get_function(jl_base_module, "islocked"_sym);
-        return jl_unbox_bool(unsafe::call(islocked, _value));
+        return std::atomic_ref<uint32_t>(*_state).load(std::memory_order_relaxed) != 0;
     }
-}
 
+    // ###
+
+    void RWMutex::lock()
+    {
+        for (size_t i = 0; true; ++i)
+        {
+            uint32_t expected = 0;
+            if (_state.compare_exchange_weak(expected, _writer, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+
+            if (i < detail::_mutex_n_spins)
+                detail::cpu_pause();
+            else
+                detail::park(_state, expected);
+        }
+    }
+
+    bool RWMutex::try_lock()
+    {
+        uint32_t expected = 0;
+        return _state.compare_exchange_strong(expected, _writer, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    bool RWMutex::try_lock_for(std::chrono::nanoseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (size_t i = 0; true; ++i)
+        {
+            uint32_t expected = 0;
+            if (_state.compare_exchange_weak(expected, _writer, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+
+            detail::backoff(i);
+        }
+    }
+
+    void RWMutex::unlock()
+    {
+        _state.store(0, std::memory_order_release);
+        _state.notify_all();
+    }
+
+    void RWMutex::lock_shared()
+    {
+        for (size_t i = 0; true; ++i)
+        {
+            uint32_t current = _state.load(std::memory_order_relaxed);
+            if ((current & _writer) == 0 and _state.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+
+            if (i < detail::_mutex_n_spins)
+                detail::cpu_pause();
+            else if (current & _writer)
+                detail::park(_state, current);
+        }
+    }
+
+    bool RWMutex::try_lock_shared()
+    {
+        uint32_t current = _state.load(std::memory_order_relaxed);
+        while ((current & _writer) == 0)
+            if (_state.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+
+        return false;
+    }
+
+    bool RWMutex::try_lock_shared_for(std::chrono::nanoseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (size_t i = 0; true; ++i)
+        {
+            if (try_lock_shared())
+                return true;
+
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+
+            detail::backoff(i);
+        }
+    }
+
+    void RWMutex::unlock_shared()
+    {
+        // last reader wakes up waiting writers
+        if (_state.fetch_sub(1, std::memory_order_release) == 1)
+            _state.notify_all();
+    }
+}
@@ -18,7 +18,7 @@ namespace jluna
     {
         jluna::detail::assert_type(
             (unsafe::DataType*) jl_typeof(in),
-            (unsafe::DataType*) jl_eval_string("return Base.ReentrantLock")
+            (unsafe::DataType*) jl_eval_string("return jluna.Mutex")
         );
 
         return Mutex(in);
@@ -14,8 +14,8 @@
 namespace jluna
 {
     // no owner
-    Proxy::ProxyValue::ProxyValue(unsafe::Value* value, jl_sym_t* id)
-        : _is_mutating(id != nullptr)
+    Proxy::ProxyValue::ProxyValue(unsafe::Value* value, jl_sym_t* id, bool is_permanent)
+        : _is_mutating(id != nullptr), _is_permanent(is_permanent and id != nullptr)
     {
         if (not jl_is_initialized())
         {
@@ -23,6 +23,14 @@ namespace jluna
             return;
         }
 
+        // named proxy id of a Main-level symbol is the symbol itself, see jluna.memory_handler.make_named_proxy_id
+        if (_is_permanent)
+        {
+            _value_ref = value;
+            _id_ref = (unsafe::Value*) id;
+            return;
+        }
+
         static jl_function_t* make_unnamed_proxy_id = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "make_unnamed_proxy_id"_sym);
         static jl_function_t* make_named_proxy_id = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "make_named_proxy_id"_sym);
 
@@ -57,12 +65,32 @@ namespace jluna
 
     Proxy::ProxyValue::~ProxyValue()
     {
+        if (_is_permanent)
+            return;
+
         detail::free_reference(_value_key);
         detail::free_reference(_id_key);
     }
 
+    void Proxy::ProxyValue::make_referenced()
+    {
+        if (not _is_permanent)
+            return;
+
+        gc_pause;
+        _value_key = detail::create_reference(_value_ref);
+        _id_key = detail::create_reference(_id_ref);
+        _value_ref = detail::get_reference(_value_key);
+        _id_ref = detail::get_reference(_id_key);
+        _is_permanent = false;
+        gc_unpause;
+    }
+
     unsafe::Value* Proxy::ProxyValue::value() const
     {
+        if (_is_permanent)
+            return _value_ref;
+
         JL_TRY
             return jl_get_nth_field(_value_ref, 0);
         JL_CATCH
@@ -73,6 +101,9 @@ namespace jluna
 
     unsafe::Value* Proxy::ProxyValue::id() const
     {
+        if (_is_permanent)
+            return _id_ref;
+
         JL_TRY
             return jl_get_nth_field(_id_ref, 0);
         JL_CATCH
@@ -106,6 +137,10 @@ namespace jluna
         : _content(new ProxyValue(value, symbol))
     {}
 
+    Proxy::Proxy(unsafe::Value* value, jl_sym_t* symbol, bool is_permanent)
+        : _content(new ProxyValue(value, symbol, is_permanent))
+    {}
+
     Proxy::~Proxy()
     {
         _content.reset();
@@ -189,6 +224,7 @@ namespace jluna
         static jl_function_t* assign = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "assign"_sym);
         static jl_function_t* set_reference = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "set_reference"_sym);
 
+        _content->make_referenced();
         _content->_value_ref = jluna::safe_call(set_reference, jl_box_uint64(_content->_value_key), new_value);
 
         if (_content->_is_mutating)
@@ -211,6 +247,7 @@ namespace jluna
 
         gc_pause;
         auto* new_value = jluna::safe_call(evaluate, _content->id());
+        _content->make_referenced();
         _content->_value_ref = jluna::safe_call(set_reference, jl_box_uint64(_content->_value_key), new_value);
         gc_unpause;
     }
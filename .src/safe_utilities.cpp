@@ -8,6 +8,8 @@
 #include <.src/include_julia.inl>
 #include <include/type.hpp>
 #include <include/module.hpp>
+#include <include/startup_report.hpp>
+#include <filesystem>
 #include <mutex>
 
 namespace jluna
@@ -15,13 +17,31 @@ namespace jluna
     namespace detail
     {
         static inline std::mutex initialize_lock = std::mutex();
+
+        // is Main.jluna already loaded from a sysimage built by the jluna_sysimage target, from the same source. Per-thread state grows with the thread ids in use, so the number of threads does not have to match
+        static bool is_jluna_in_image()
+        {
+            auto* is_in_image = jl_eval_string(R"(
+                function (source::String) ::Bool
+                    isdefined(Main, :jluna) && isdefined(Main.jluna, :_image_source_hash) || return false
+                    return Main.jluna._image_source_hash == hash(source)
+                end
+            )");
+            forward_last_exception();
+
+            auto* out = jl_call1(is_in_image, jl_cstr_to_string(detail::julia_source));
+            forward_last_exception();
+            return jl_unbox_bool(out);
+        }
     }
 
     void initialize(
         size_t n_threads,
         bool suppress_log,
         const std::string& jluna_shared_library_path,
-        const std::string& julia_image_path
+        const std::string& julia_image_path,
+        [[maybe_unused]] size_t n_interactive_threads,
+        bool profile_startup
     )
     {
         static bool is_initialized = false;
@@ -34,29 +54,51 @@ namespace jluna
             return;
         }
 
+        // `default,interactive`, supported since Julia 1.9
+        std::string num_threads = n_threads == 0 ? "auto" : std::to_string(n_threads);
+
+        #if defined(JULIA_VERSION_MAJOR) and (JULIA_VERSION_MAJOR > 1 or (JULIA_VERSION_MAJOR == 1 and JULIA_VERSION_MINOR >= 9))
+            if (n_interactive_threads > 0)
+                num_threads += "," + std::to_string(n_interactive_threads);
+        #endif
+
         #ifdef _WIN32
         {
             std::stringstream str;
-            str << "JULIA_NUM_THREADS=" << (n_threads == 0 ? "auto" : std::to_string(n_threads)) << std::endl;
+            str << "JULIA_NUM_THREADS=" << num_threads << std::endl;
             _putenv(str.str().c_str());
         }
         #else
-            setenv("JULIA_NUM_THREADS", std::string(n_threads == 0 ? "auto" : std::to_string(n_threads)).c_str(), 1);
+            setenv("JULIA_NUM_THREADS", num_threads.c_str(), 1);
         #endif
 
         detail::_num_threads = n_threads;
+        auto profiler = detail::StartupProfiler(profile_startup);
+
+        profiler.begin("jl_init");
         if (julia_image_path.empty())
             jl_init();
+        else if (std::filesystem::is_regular_file(julia_image_path))
+        {
+            // same bindir as jl_init
+            auto bindir = std::string(jl_get_libdir()) + "/../bin";
+            jl_init_with_image(bindir.c_str(), std::filesystem::absolute(julia_image_path).string().c_str());
+        }
         else
             jl_init_with_image(julia_image_path.c_str(), nullptr);
 
         forward_last_exception();
 
-        bool success = jl_unbox_bool(jl_eval_string(detail::julia_source));
-        forward_last_exception();
+        profiler.begin("evaluate jluna source");
+        if (not detail::is_jluna_in_image())
+        {
+            bool success = jl_unbox_bool(jl_eval_string(detail::julia_source));
+            forward_last_exception();
 
-        assert(success);
+            assert(success);
+        }
 
+        profiler.begin("version check");
         jl_eval_string(R"(
             begin
                 local version = tryparse(Float32, SubString(string(VERSION), 1, 3))
@@ -68,6 +110,7 @@ namespace jluna
         )");
         forward_last_exception();
 
+        profiler.begin("set cppcall._lib");
         std::stringstream str;
         str << "jluna.cppcall.eval(:(const _lib = \""
             << (jluna_shared_library_path == "" ? jluna::detail::shared_library_name : jluna_shared_library_path)
@@ -76,9 +119,14 @@ namespace jluna
         jl_eval_string(str.str().c_str());
         forward_last_exception();
 
+        profiler.begin("initialize_modules");
         detail::initialize_modules();
+
+        profiler.begin("initialize_types");
         detail::initialize_types();
 
+        // first call of safe_eval, includes compiling jluna.safe_call
+        profiler.begin("first call");
         if (suppress_log)
         {
             safe_eval(R"(
@@ -103,6 +151,8 @@ namespace jluna
             )");
         }
 
+        profiler.finish();
+
         std::atexit(&jluna::detail::on_exit);
         is_initialized = true;
 
@@ -202,68 +252,78 @@ namespace jluna::detail
 
     void initialize_types()
     {
-        auto unroll = [](const std::string& name) -> jl_datatype_t*
+        // all of these are declared in Core or Base, such that they are never garbage collected and do not need to be registered with the memory handler
+        auto permanent = [](unsafe::Value* type) -> Type
+        {
+            // equivalent to jluna.unroll_type
+            while (jl_is_unionall(type))
+                type = ((jl_unionall_t*) type)->body;
+
+            return Type((jl_datatype_t*) type, true);
+        };
+
+        auto from_module = [&](unsafe::Module* module, const char* name) -> Type
         {
-            return (jl_datatype_t*) jl_eval_string(("return jluna.unroll_type(" + name + ")").c_str());
+            return permanent(jl_get_global(module, jl_symbol(name)));
         };
 
         gc_pause;
-        AbstractArray_t = Type(unroll("Core.AbstractArray"));
-        AbstractChar_t = Type(unroll("Core.AbstractChar"));
-        AbstractFloat_t = Type(unroll("Core.AbstractFloat"));
-        AbstractString_t = Type(unroll("Core.AbstractString"));
-        Any_t = Type(unroll("Core.Any"));
-        Array_t = Type(unroll("Core.Array"));
-        Bool_t = Type(unroll("Core.Bool"));
-        Char_t = Type(unroll("Core.Char"));
-        DataType_t = Type(unroll("Core.DataType"));
-        DenseArray_t = Type(unroll("Core.DenseArray"));
-        Exception_t = Type(unroll("Core.Exception"));
-        Expr_t = Type(unroll("Core.Expr"));
-        Float16_t = Type(unroll("Core.Float16"));
-        Float32_t = Type(unroll("Core.Float32"));
-        Float64_t = Type(unroll("Core.Float64"));
-        Function_t = Type(unroll("Core.Function"));
-        GlobalRef_t = Type(unroll("Core.GlobalRef"));
-        IO_t = Type(unroll("Core.IO"));
-        Int128_t = Type(unroll("Core.Int128"));
-        Int16_t = Type(unroll("Core.Int16"));
-        Int32_t = Type(unroll("Core.Int32"));
-        Int64_t = Type(unroll("Core.Int64"));
-        Int8_t = Type(unroll("Core.Int8"));
-        Integer_t = Type(unroll("Core.Integer"));
-        LineNumberNode_t = Type(unroll("Core.LineNumberNode"));
-        Method_t = Type(unroll("Core.Method"));
-        Module_t = Type(unroll("Core.Module"));
-        Missing_t = Type(unroll("Base.Missing"));
-        NTuple_t = Type(unroll("Core.NTuple"));
-        NamedTuple_t = Type(unroll("Core.NamedTuple"));
-        Nothing_t = Type(unroll("Core.Nothing"));
-        Number_t = Type(unroll("Core.Number"));
-        Pair_t = Type(unroll("Core.Pair"));
-        Ptr_t = Type(unroll("Core.Ptr"));
-        QuoteNode_t = Type(unroll("Core.QuoteNode"));
-        Real_t = Type(unroll("Core.Real"));
-        Ref_t = Type(unroll("Core.Ref"));
-        Signed_t = Type(unroll("Core.Signed"));
-        String_t = Type(unroll("Core.String"));
-        Symbol_t = Type(unroll("Core.Symbol"));
-        Task_t = Type(unroll("Core.Task"));
-        Tuple_t = Type(unroll("Core.Tuple"));
-        Type_t = Type(unroll("Core.Type"));
-        TypeVar_t = Type(unroll("Core.TypeVar"));
-        UInt128_t = Type(unroll("Core.UInt128"));
-        UInt16_t = Type(unroll("Core.UInt16"));
-        UInt32_t = Type(unroll("Core.UInt32"));
-        UInt64_t = Type(unroll("Core.UInt64"));
-        UInt8_t = Type(unroll("Core.UInt8"));
-        UndefInitializer_t = Type(unroll("Core.UndefInitializer"));
-        Union_t = Type(unroll("Core.Union"));
-        UnionAll_t = Type(unroll("Core.UnionAll"));
-        UnionEmpty_t = Type(unroll("Union{}"));
-        Unsigned_t = Type(unroll("Core.Unsigned"));
-        VecElement_t = Type(unroll("Core.VecElement"));
-        WeakRef_t = Type(unroll("Core.WeakRef"));
+        AbstractArray_t = permanent((unsafe::Value*) jl_abstractarray_type);
+        AbstractChar_t = from_module(jl_core_module, "AbstractChar");
+        AbstractFloat_t = permanent((unsafe::Value*) jl_floatingpoint_type);
+        AbstractString_t = permanent((unsafe::Value*) jl_abstractstring_type);
+        Any_t = permanent((unsafe::Value*) jl_any_type);
+        Array_t = permanent((unsafe::Value*) jl_array_type);
+        Bool_t = permanent((unsafe::Value*) jl_bool_type);
+        Char_t = permanent((unsafe::Value*) jl_char_type);
+        DataType_t = permanent((unsafe::Value*) jl_datatype_type);
+        DenseArray_t = permanent((unsafe::Value*) jl_densearray_type);
+        Exception_t = from_module(jl_core_module, "Exception");
+        Expr_t = permanent((unsafe::Value*) jl_expr_type);
+        Float16_t = permanent((unsafe::Value*) jl_float16_type);
+        Float32_t = permanent((unsafe::Value*) jl_float32_type);
+        Float64_t = permanent((unsafe::Value*) jl_float64_type);
+        Function_t = permanent((unsafe::Value*) jl_function_type);
+        GlobalRef_t = permanent((unsafe::Value*) jl_globalref_type);
+        IO_t = from_module(jl_core_module, "IO");
+        Int128_t = from_module(jl_core_module, "Int128");
+        Int16_t = permanent((unsafe::Value*) jl_int16_type);
+        Int32_t = permanent((unsafe::Value*) jl_int32_type);
+        Int64_t = permanent((unsafe::Value*) jl_int64_type);
+        Int8_t = permanent((unsafe::Value*) jl_int8_type);
+        Integer_t = from_module(jl_core_module, "Integer");
+        LineNumberNode_t = permanent((unsafe::Value*) jl_linenumbernode_type);
+        Method_t = permanent((unsafe::Value*) jl_method_type);
+        Module_t = permanent((unsafe::Value*) jl_module_type);
+        Missing_t = from_module(jl_base_module, "Missing");
+        NTuple_t = from_module(jl_core_module, "NTuple");
+        NamedTuple_t = permanent((unsafe::Value*) jl_namedtuple_type);
+        Nothing_t = permanent((unsafe::Value*) jl_nothing_type);
+        Number_t = permanent((unsafe::Value*) jl_number_type);
+        Pair_t = permanent((unsafe::Value*) jl_pair_type);
+        Ptr_t = permanent((unsafe::Value*) jl_pointer_type);
+        QuoteNode_t = permanent((unsafe::Value*) jl_quotenode_type);
+        Real_t = from_module(jl_core_module, "Real");
+        Ref_t = permanent((unsafe::Value*) jl_ref_type);
+        Signed_t = permanent((unsafe::Value*) jl_signed_type);
+        String_t = permanent((unsafe::Value*) jl_string_type);
+        Symbol_t = permanent((unsafe::Value*) jl_symbol_type);
+        Task_t = permanent((unsafe::Value*) jl_task_type);
+        Tuple_t = permanent((unsafe::Value*) jl_tuple_type);
+        Type_t = permanent((unsafe::Value*) jl_type_type);
+        TypeVar_t = from_module(jl_core_module, "TypeVar");
+        UInt128_t = from_module(jl_core_module, "UInt128");
+        UInt16_t = permanent((unsafe::Value*) jl_uint16_type);
+        UInt32_t = permanent((unsafe::Value*) jl_uint32_type);
+        UInt64_t = permanent((unsafe::Value*) jl_uint64_type);
+        UInt8_t = permanent((unsafe::Value*) jl_uint8_type);
+        UndefInitializer_t = from_module(jl_core_module, "UndefInitializer");
+        Union_t = permanent((unsafe::Value*) jl_uniontype_type);
+        UnionAll_t = permanent((unsafe::Value*) jl_unionall_type);
+        UnionEmpty_t = permanent((unsafe::Value*) jl_bottom_type);
+        Unsigned_t = from_module(jl_core_module, "Unsigned");
+        VecElement_t = from_module(jl_core_module, "VecElement");
+        WeakRef_t = permanent((unsafe::Value*) jl_weakref_type);
         gc_unpause;
     }
 
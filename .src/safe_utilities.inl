@@ -41,7 +41,7 @@ namespace jluna
         auto* tuple_res = jl_call(jl_safe_call, args.data(), args.size());
 
         if (jl_unbox_bool(jl_get_nth_field(tuple_res, 1)))
-            throw JuliaException(jl_get_nth_field(tuple_res, 2), jl_string_ptr(jl_get_nth_field(tuple_res, 3)));
+            detail::throw_julia_exception(jl_get_nth_field(tuple_res, 2), jl_string_ptr(jl_get_nth_field(tuple_res, 3)));
 
         auto* res = jl_get_nth_field(tuple_res, 0);
         return res;
@@ -0,0 +1,170 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <include/startup_report.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+// declared with the signatures Base.gc_bytes and Base.cumulative_compile_time_ns ccall them with, not all versions of julia.h declare them
+extern "C"
+{
+    void jl_gc_get_total_bytes(int64_t*);
+
+    #if defined(JULIA_VERSION_MAJOR) and (JULIA_VERSION_MAJOR > 1 or (JULIA_VERSION_MAJOR == 1 and JULIA_VERSION_MINOR >= 8))
+        #define JLUNA_HAS_COMPILE_TIMING
+        uint64_t jl_cumulative_compile_time_ns(void);
+        void jl_cumulative_compile_timing_enable(void);
+        void jl_cumulative_compile_timing_disable(void);
+    #endif
+}
+
+namespace jluna
+{
+    namespace detail
+    {
+        static inline StartupReport _startup_report = StartupReport();
+
+        static int64_t gc_total_bytes()
+        {
+            if (not jl_is_initialized())
+                return 0;
+
+            int64_t out = 0;
+            jl_gc_get_total_bytes(&out);
+            return out;
+        }
+
+        static uint64_t cumulative_compile_time()
+        {
+            #ifdef JLUNA_HAS_COMPILE_TIMING
+                return jl_cumulative_compile_time_ns();
+            #else
+                return 0;
+            #endif
+        }
+    }
+
+    std::chrono::nanoseconds StartupReport::total_wall_time() const
+    {
+        auto out = std::chrono::nanoseconds(0);
+        for (auto& phase : phases)
+            out += phase.wall_time;
+
+        return out;
+    }
+
+    std::chrono::nanoseconds StartupReport::total_compile_time() const
+    {
+        auto out = std::chrono::nanoseconds(0);
+        for (auto& phase : phases)
+            out += phase.compile_time;
+
+        return out;
+    }
+
+    uint64_t StartupReport::total_bytes_allocated() const
+    {
+        uint64_t out = 0;
+        for (auto& phase : phases)
+            out += phase.n_bytes_allocated;
+
+        return out;
+    }
+
+    std::string StartupReport::to_json() const
+    {
+        std::stringstream str;
+        str << "{\"phases\": [";
+
+        for (size_t i = 0; i < phases.size(); ++i)
+        {
+            auto& phase = phases.at(i);
+            str << (i == 0 ? "" : ", ")
+                << "{\"name\": \"" << phase.name << "\", "
+                << "\"wall_time_ns\": " << phase.wall_time.count() << ", "
+                << "\"compile_time_ns\": " << phase.compile_time.count() << ", "
+                << "\"bytes_allocated\": " << phase.n_bytes_allocated << "}";
+        }
+
+        str << "], "
+            << "\"total_wall_time_ns\": " << total_wall_time().count() << ", "
+            << "\"total_compile_time_ns\": " << total_compile_time().count() << ", "
+            << "\"total_bytes_allocated\": " << total_bytes_allocated() << "}";
+
+        return str.str();
+    }
+
+    const StartupReport& startup_report()
+    {
+        return detail::_startup_report;
+    }
+
+    namespace detail
+    {
+        StartupProfiler::StartupProfiler(bool enabled)
+            : _enabled(enabled)
+        {}
+
+        void StartupProfiler::begin(const std::string& name)
+        {
+            if (not _enabled)
+                return;
+
+            end();
+
+            // compile timing can only be enabled once the Julia state exists, so the jl_init phase never reports compile time
+            #ifdef JLUNA_HAS_COMPILE_TIMING
+                if (not _is_timing_compilation and jl_is_initialized())
+                {
+                    jl_cumulative_compile_timing_enable();
+                    _is_timing_compilation = true;
+                }
+            #endif
+
+            _name = name;
+            _compile_time_start = cumulative_compile_time();
+            _bytes_start = gc_total_bytes();
+            _start = std::chrono::steady_clock::now();
+        }
+
+        void StartupProfiler::end()
+        {
+            if (not _enabled or _name.empty())
+                return;
+
+            auto wall_time = std::chrono::steady_clock::now() - _start;
+            auto compile_time = _is_timing_compilation ? cumulative_compile_time() - _compile_time_start : 0;
+            auto bytes = gc_total_bytes() - _bytes_start;
+
+            _report.phases.push_back(StartupPhase{
+                _name,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(wall_time),
+                std::chrono::nanoseconds(compile_time),
+                uint64_t(std::max<int64_t>(0, bytes))
+            });
+
+            _name.clear();
+        }
+
+        void StartupProfiler::finish()
+        {
+            if (not _enabled)
+                return;
+
+            end();
+
+            #ifdef JLUNA_HAS_COMPILE_TIMING
+                if (_is_timing_compilation)
+                {
+                    jl_cumulative_compile_timing_disable();
+                    _is_timing_compilation = false;
+                }
+            #endif
+
+            _startup_report = _report;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#include <include/thread_guard.hpp>
+
+#include <stdexcept>
+
+namespace jluna
+{
+    ThreadGuard::ThreadGuard()
+    {
+        #if JLUNA_THREAD_ADOPTION_SUPPORTED
+            if (jl_get_pgcstack() == nullptr)
+            {
+                jl_adopt_thread();
+                _ptls = jl_current_task->ptls;
+
+                // adoption leaves the thread in the unsafe state, the dtor moves it to the safe state, such that the gc does not wait on this thread
+                _state = JL_GC_STATE_SAFE;
+            }
+            else
+            {
+                _ptls = jl_current_task->ptls;
+                _state = jl_gc_unsafe_enter(_ptls);
+            }
+        #else
+            if (not is_julia_thread())
+                throw std::runtime_error("In jluna::ThreadGuard: adopting a C++-side thread requires Julia 1.9 or newer");
+        #endif
+    }
+
+    ThreadGuard::~ThreadGuard()
+    {
+        #if JLUNA_THREAD_ADOPTION_SUPPORTED
+            jl_gc_unsafe_leave(_ptls, _state);
+        #endif
+    }
+
+    bool ThreadGuard::is_supported()
+    {
+        return JLUNA_THREAD_ADOPTION_SUPPORTED;
+    }
+
+    bool ThreadGuard::is_julia_thread()
+    {
+        // thread-local gc stack is only initialized for threads known to Julia
+        return jl_get_pgcstack() != nullptr;
+    }
+}
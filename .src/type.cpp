@@ -14,6 +14,10 @@ namespace jluna
         : Proxy((unsafe::Value*) value, (value->name == NULL ? jl_symbol("Union{}") : value->name->name))
     {}
 
+    Type::Type(jl_datatype_t* value, bool is_permanent)
+        : Proxy((unsafe::Value*) value, (value->name == NULL ? jl_symbol("Union{}") : value->name->name), is_permanent)
+    {}
+
     Type::Type(Proxy* owner)
         : Proxy(*owner)
     {
@@ -67,7 +67,7 @@ namespace jluna
         template<>
         struct as_julia_type_aux<uint16_t>
         {
-            static inline const std::string type_name = "UInt8";
+            static inline const std::string type_name = "UInt16";
         };
 
         template<>
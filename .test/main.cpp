@@ -20,13 +20,41 @@ struct NonJuliaType
 };
 set_usertype_enabled(NonJuliaType);
 
+// coroutine that starts eagerly and is never awaited, used to test jluna::TaskAwaiter
+struct DetachedCoroutine
+{
+    struct promise_type
+    {
+        DetachedCoroutine get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
 #include <thread>
+#include <future>
+#include <shared_mutex>
 
 int main()
 {
-    initialize(2);
+    initialize(2, false, "", "", 0, true);
     Test::initialize();
 
+    Test::test("startup_report", [](){
+
+        auto& report = startup_report();
+        Test::assert_that(report.phases.size() == 7);
+        Test::assert_that(report.phases.front().name == "jl_init");
+        Test::assert_that(report.phases.back().name == "first call");
+        Test::assert_that(report.total_wall_time() > std::chrono::nanoseconds(0));
+
+        auto json = report.to_json();
+        Test::assert_that(json.front() == '{' and json.back() == '}');
+        Test::assert_that(json.find("{\"name\": \"initialize_types\", \"wall_time_ns\": ") != std::string::npos);
+    });
+
     Test::test("c_adapter found", [](){
 
         auto a = safe_eval("return jluna.cppcall.verify_library()");
@@ -402,6 +430,49 @@ int main()
         });
     });
 
+    Test::test("CompiledExpression", []() {
+
+        Main.safe_eval("compiled_counter = 0");
+        auto increment = CompiledExpression(R"(
+            global compiled_counter += 1
+            return compiled_counter
+        )");
+
+        for (size_t i = 0; i < 10; ++i)
+            increment();
+
+        Test::assert_that(increment.evaluate<Int64>() == 11);
+        Test::assert_that(Main["compiled_counter"].operator Int64() == 11);
+
+        auto add = CompiledExpression("a + b * 2", {"a", "b"});
+        Test::assert_that(add.n_parameters() == 2);
+        Test::assert_that(add.evaluate<Int64>(1, 2) == 5);
+        Test::assert_that(add(1.5, 2).operator Float64() == 5.5);
+
+        Test::assert_that_throws<std::invalid_argument>([&]() {
+            add.evaluate<Int64>(1);
+        });
+
+        auto assigned = CompiledExpression("return 0");
+        {
+            auto source = CompiledExpression("a - b", {"a", "b"});
+            assigned = source;
+        }
+
+        Main.safe_eval("GC.gc()");
+        Test::assert_that(assigned.n_parameters() == 2);
+        Test::assert_that(assigned.get_code() == "a - b");
+        Test::assert_that(assigned.evaluate<Int64>(3, 1) == 2);
+
+        Test::assert_that_throws<JuliaException>([]() {
+            CompiledExpression("a +* b");
+        });
+
+        Test::assert_that_throws<JuliaException>([]() {
+            CompiledExpression("throw(ErrorException(\"abc\"))").evaluate<void>();
+        });
+    });
+
     auto test_box_unbox = []<typename T>(const std::string type_name, T value) {
         Test::test("box/unbox " + type_name, [value]() {
 
@@ -542,6 +613,83 @@ int main()
         //jl_eval_string("test = undef");
     });
 
+    Test::test("Module: assign_many", []() {
+
+        Main.create_or_assign_many({
+            {"batch_a", 1},
+            {"batch_b", std::string("abc")},
+            {"batch_c", std::vector<Int64>{1, 2, 3}}
+        });
+
+        Main.safe_eval(R"(@assert batch_a == 1 && batch_b == "abc" && batch_c == [1, 2, 3])");
+
+        auto batch = AssignmentBatch();
+        for (size_t i = 0; i < 100; ++i)
+            batch.add("batch_" + std::to_string(i), i);
+
+        Test::assert_that(batch.size() == 100);
+        Main.create_or_assign_many(batch);
+        Main.safe_eval("@assert batch_99 == 99");
+
+        Main.assign_many({{"batch_a", 2}, {"batch_b", 3}});
+        Main.safe_eval("@assert batch_a == 2 && batch_b == 3");
+
+        // either all or none are assigned
+        Test::assert_that_throws<JuliaException>([](){
+            Main.assign_many({{"batch_a", 4}, {"batch_undefined", 4}});
+        });
+        Main.safe_eval("@assert batch_a == 2");
+
+        // constants and typed globals are checked before anything is assigned
+        Main.safe_eval("const batch_const = 1");
+        Test::assert_that_throws<JuliaException>([](){
+            Main.create_or_assign_many({{"batch_a", 5}, {"batch_const", 2}});
+        });
+        Main.safe_eval("@assert batch_a == 2 && batch_const == 1");
+
+        #if defined(JULIA_VERSION_MAJOR) and (JULIA_VERSION_MAJOR > 1 or (JULIA_VERSION_MAJOR == 1 and JULIA_VERSION_MINOR >= 9))
+            Main.safe_eval("global batch_typed::Int64 = 1");
+            Test::assert_that_throws<JuliaException>([](){
+                Main.assign_many({{"batch_a", 6}, {"batch_typed", std::string("abc")}});
+            });
+            Main.safe_eval("@assert batch_a == 2 && batch_typed == 1");
+        #endif
+    });
+
+    Test::test("Module: binding", []() {
+
+        Main.safe_eval("binding_var = 1");
+        auto var = Main.binding<Int64>("binding_var");
+        Test::assert_that(var.get() == 1);
+        Test::assert_that(not var.is_const());
+
+        // rebinding is reflected
+        Main.safe_eval("binding_var = 2");
+        Test::assert_that(var.get() == 2);
+
+        // converted if the type differs
+        Main.safe_eval("binding_var = Int32(3)");
+        Test::assert_that(var.get() == 3);
+
+        Main.safe_eval("const binding_const = 1.5");
+        auto as_const = Main.binding<Float64>("binding_const");
+        Test::assert_that(as_const.is_const());
+        Test::assert_that(as_const.operator Float64() == 1.5);
+
+        // redefining a constant prints a warning, but the new value is read, not one cached at construction
+        Main.safe_eval("const binding_const = 2.5");
+        Test::assert_that(as_const.get() == 2.5);
+
+        Main.safe_eval("binding_string = \"abc\"");
+        auto as_string = Main.binding<std::string>("binding_string");
+        Test::assert_that(as_string.get() == "abc");
+        Test::assert_that(as_string.get_name() == "binding_string");
+
+        Test::assert_that_throws<JuliaException>([](){
+            Main.binding<Int64>("binding_undefined");
+        });
+    });
+
     Test::test("create_reference", []() {
 
         Main.safe_eval(R"(
@@ -1051,6 +1199,40 @@ int main()
             Test::assert_that(it.operator int() % 2 == 0);
     });
 
+    Test::test("array: slice", []() {
+
+        Main.safe_eval("array = reshape(collect(1:27), 3, 3, 3)");
+        Array<Int64, 3> arr = Main["array"];
+
+        auto view = arr.slice({0, 2}, all, 1);
+        Test::assert_that(view.get_rank() == 2 and view.size(0) == 2 and view.size(1) == 3);
+        Test::assert_that(view.at(1, 2) == (Int64) arr.at(1, 2, 1));
+        Test::assert_that(jl_unbox_bool(safe_call(jl_get_function(jl_base_module, "isa"), (unsafe::Value*) view, jl_eval_string("return SubArray"))));
+
+        view.set(0, 999);
+        Test::assert_that((Int64) arr.at(0, 0, 1) == 999);
+
+        auto strided = arr.slice({0, 3, 2}, 1, 2);
+        Test::assert_that(strided.get_n_elements() == 2 and strided[1] == (Int64) arr.at(2, 1, 2));
+
+        auto copy = view.copy<2>();
+        copy.set(0, 0);
+        Test::assert_that((Int64) arr.at(0, 0, 1) == 999);
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            arr.slice({0, 4}, all, all);
+        });
+    });
+
+    Test::test("array: view from SubArray", []() {
+
+        ArrayView<Int64> view = Main.safe_eval("return view(collect(1:10), 2:2:10)");
+        Test::assert_that(view.get_n_elements() == 5 and view[0] == 2 and view[4] == 10);
+
+        Vector<Int64> as_vector = view.copy();
+        Test::assert_that(as_vector.get_n_elements() == 5 and as_vector.back<Int64>() == 10);
+    });
+
     Test::test("vector: insert", []() {
 
         Main.safe_eval("vector = UInt64[1, 2, 3, 4]");
@@ -1078,6 +1260,55 @@ int main()
         Test::assert_that(vec.get_n_elements() == 6 and vec.front<int>() == 999 and vec.back<int>() == 666);
     });
 
+    Test::test("vector: append range", []() {
+
+        Main.safe_eval("vector = Int64[1, 2]");
+        Vector<Int64> vec = Main["vector"];
+
+        vec.append(std::vector<Int64>{3, 4, 5});
+        vec.append(std::set<Int32>{6, 7});
+        Test::assert_that(vec.get_n_elements() == 7 and vec.back<Int64>() == 7);
+        Main.safe_eval("@assert vector == collect(1:7)");
+
+        Main.safe_eval("vector = String[\"a\"]");
+        Vector<std::string> str = Main["vector"];
+
+        str.append(std::vector<std::string>{"b", "c"});
+        Main.safe_eval("@assert vector == [\"a\", \"b\", \"c\"]");
+    });
+
+    Test::test("vector: insert range", []() {
+
+        Main.safe_eval("vector = Float64[1, 4]");
+        Vector<Float64> vec = Main["vector"];
+
+        vec.insert(1, std::vector<Float64>{2, 3});
+        Main.safe_eval("@assert vector == [1, 2, 3, 4]");
+
+        Main.safe_eval("vector = String[\"a\", \"d\"]");
+        Vector<std::string> str = Main["vector"];
+
+        str.insert(1, std::vector<std::string>{"b", "c"});
+        Main.safe_eval("@assert vector == [\"a\", \"b\", \"c\", \"d\"]");
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            vec.insert(99, std::vector<Float64>{1});
+        });
+    });
+
+    Test::test("vector: erase range", []() {
+
+        Main.safe_eval("vector = Int64[1, 2, 3, 4, 5]");
+        Vector<Int64> vec = Main["vector"];
+
+        vec.erase(1, 3);
+        Main.safe_eval("@assert vector == [1, 4, 5]");
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            vec.erase(2, 4);
+        });
+    });
+
     Test::test("C: initialize adapter", []() {
 
     });
@@ -1138,6 +1369,112 @@ int main()
         }
     });
 
+    Test::test("C: any number of arguments", []() {
+
+        Main.create_or_assign("eight", as_julia_function<Int64(Int64, Int64, Int64, Int64, Int64, Int64, Int64, std::string)>(
+            [](Int64 a, Int64 b, Int64 c, Int64 d, Int64 e, Int64 f, Int64 g, std::string h) -> Int64 {
+                return a + b + c + d + e + f + g + h.size();
+            }
+        ));
+
+        Main.safe_eval("@assert eight(1, 2, 3, 4, 5, 6, 7, \"abc\") == 31");
+
+        auto f = std::function<std::string(std::string, std::string, std::string, std::string)>([](std::string a, std::string b, std::string c, std::string d){
+            return a + b + c + d;
+        });
+        Main.create_or_assign("four", register_function(f));
+        Main.safe_eval(R"(@assert four("a", "b", "c", "d") == "abcd")");
+
+        Test::assert_that_throws<JuliaException>([](){
+            Main.safe_eval("four(\"a\")");
+        });
+    });
+
+    Test::test("C: declared types", []() {
+
+        Main.create_or_assign("typed_f", as_julia_function<Int64(Int64, std::string)>(
+            [](Int64 a, std::string b) -> Int64 {
+                return a + b.size();
+            }
+        ));
+
+        Main.safe_eval("@assert typed_f isa jluna.cppcall.UnnamedFunction{Int64, Tuple{Int64, String}}");
+        Main.safe_eval("@assert Base.return_types(typed_f, (Int64, String)) == [Int64]");
+        Main.safe_eval("@assert typed_f(1, \"abc\") === 4");
+
+        Main.create_or_assign("void_f", as_julia_function<void()>([](){}));
+        Main.safe_eval("@assert Base.return_types(void_f, ()) == [Nothing]");
+
+        // boxed type may differ from as_julia_type, declared as Any
+        Main.create_or_assign("vector_f", as_julia_function<std::vector<Int64>(Int64)>([](Int64 n){
+            return std::vector<Int64>(n, 1);
+        }));
+        Main.safe_eval("@assert vector_f isa jluna.cppcall.UnnamedFunction{Any, Tuple{Any}}");
+        Main.safe_eval("@assert vector_f(3) == [1, 1, 1]");
+    });
+
+    Test::test("C: native function", []() {
+
+        Main.create_or_assign("native_f", register_native_function<double(double, int64_t)>(
+            [](double a, int64_t b) -> double {
+                return a * b;
+            }
+        ));
+
+        Main.safe_eval("@assert native_f(1.5, 2) === 3.0");
+        Main.safe_eval("@assert native_f(2, Int32(3)) === 6.0");
+        Main.safe_eval("@assert Base.return_types(native_f, (Float64, Int64)) == [Float64]");
+
+        static size_t n_called = 0;
+        Main.create_or_assign("native_void", register_native_function<void(bool)>(
+            [](bool b) -> void {
+                if (b)
+                    n_called += 1;
+            }
+        ));
+
+        Main.safe_eval("@assert native_void(true) === nothing");
+        Main.safe_eval("native_void(false)");
+        Test::assert_that(n_called == 1);
+
+        Test::assert_that_throws<JuliaException>([](){
+            Main.safe_eval("native_f(1.0)");
+        });
+
+        Test::assert_that_throws<JuliaException>([](){
+            Main.safe_eval("native_f(1.5, 2.5)");
+        });
+    });
+
+    Test::test("C: batch function", []() {
+
+        static size_t n_invoked = 0;
+        Main.create_or_assign("batch_f", register_batch_function<double, Int64>(
+            [](std::span<const double> in, std::span<Int64> out) -> void {
+                n_invoked += 1;
+                for (size_t i = 0; i < in.size(); ++i)
+                    out[i] = in[i] * 2;
+            }
+        ));
+
+        Main.safe_eval("batch_xs = collect(1.0:1000.0)");
+        Main.safe_eval("@assert batch_f.(batch_xs) == Int64[2i for i in 1:1000]");
+        Test::assert_that(n_invoked == 1);
+
+        Main.safe_eval("@assert map(batch_f, reshape(batch_xs, 10, 100)) == reshape(Int64[2i for i in 1:1000], 10, 100)");
+        Test::assert_that(n_invoked == 2);
+
+        // elementwise fallback
+        Main.safe_eval("@assert batch_f(1.5) === 3");
+        Test::assert_that(n_invoked == 3);
+
+        Main.safe_eval("@assert batch_f.([1, 2, 3]) == [2, 4, 6]");
+        Test::assert_that(n_invoked == 6);
+
+        Main.safe_eval("@assert batch_f.(view(batch_xs, 1:2:5)) == [2, 6, 10]");
+        Test::assert_that(n_invoked == 9);
+    });
+
     Test::test("Symbol: CTOR", []() {
 
         auto proxy = jluna::Symbol("abc");
@@ -1237,6 +1574,22 @@ int main()
         Test::assert_that(AbstractChar_t.get_symbol().operator jl_sym_t*() == jl_symbol("AbstractChar"));
     });
 
+    Test::test("Type: pre-initialized types are not referenced", []() {
+
+        auto n_refs = [](){
+            return jl_unbox_int64(jl_eval_string("return length(jluna.memory_handler._refs.x)"));
+        };
+
+        auto before = n_refs();
+        {
+            Type copy = Int64_t;
+            Test::assert_that(copy == Type(jl_int64_type));
+            Test::assert_that(Array_t.get_symbol().operator jl_sym_t*() == jl_symbol("Array"));
+            Test::assert_that(Missing_t.operator jl_datatype_t*() == (jl_datatype_t*) jl_eval_string("return Missing"));
+        }
+        Test::assert_that(n_refs() == before);
+    });
+
     Test::test("Type: get_parameters", []() {
 
         Main.safe_eval(R"(
@@ -1407,6 +1760,105 @@ int main()
         Test::assert_that(mutex.is_locked());
         mutex.unlock();
         Test::assert_that(not mutex.is_locked());
+
+        auto assigned = jluna::Mutex();
+        {
+            auto source = jluna::Mutex();
+            assigned = source;
+            source.lock();
+            Test::assert_that(assigned.is_locked());
+            source.unlock();
+        }
+
+        Main.safe_eval("GC.gc()");
+        assigned.lock();
+        Test::assert_that(assigned.is_locked());
+        assigned.unlock();
+    });
+
+    Test::test("jluna::Mutex: try_lock", [](){
+
+        auto mutex = jluna::Mutex();
+
+        Test::assert_that(mutex.try_lock());
+        Test::assert_that(not mutex.try_lock());
+        Test::assert_that(not mutex.try_lock_for(std::chrono::milliseconds(1)));
+        mutex.unlock();
+        Test::assert_that(mutex.try_lock_for(std::chrono::milliseconds(1)));
+        mutex.unlock();
+    });
+
+    Test::test("jluna::Mutex: shared with Julia", [](){
+
+        auto mutex = jluna::Mutex();
+        Main.create_or_assign("shared_mutex", mutex);
+
+        Main.safe_eval("lock(shared_mutex)");
+        Test::assert_that(mutex.is_locked());
+        Test::assert_that(not mutex.try_lock());
+
+        Main.safe_eval("unlock(shared_mutex)");
+        Test::assert_that(not mutex.is_locked());
+
+        mutex.lock();
+        Test::assert_that((bool) Main.safe_eval("return islocked(shared_mutex)"));
+        Test::assert_that(not (bool) Main.safe_eval("return trylock(shared_mutex)"));
+        mutex.unlock();
+
+        // contended from both sides
+        size_t counter = 0;
+        std::vector<Task<void>> tasks;
+        for (size_t i = 0; i < 4; ++i)
+            tasks.push_back(ThreadPool::create<void()>([&]() {
+                for (size_t j = 0; j < 1000; ++j)
+                {
+                    mutex.lock();
+                    counter += 1;
+                    mutex.unlock();
+                }
+            }));
+
+        for (auto& task : tasks)
+            task.schedule();
+
+        for (auto& task : tasks)
+            task.join();
+
+        Test::assert_that(counter == 4000);
+    });
+
+    Test::test("jluna::RWMutex", [](){
+
+        auto mutex = jluna::RWMutex();
+
+        Test::assert_that(mutex.try_lock_shared());
+        Test::assert_that(mutex.try_lock_shared());
+        Test::assert_that(not mutex.try_lock());
+        Test::assert_that(not mutex.try_lock_for(std::chrono::milliseconds(1)));
+        mutex.unlock_shared();
+        mutex.unlock_shared();
+
+        Test::assert_that(mutex.try_lock());
+        Test::assert_that(not mutex.try_lock_shared());
+        Test::assert_that(not mutex.try_lock_shared_for(std::chrono::milliseconds(1)));
+        mutex.unlock();
+
+        size_t counter = 0;
+        auto writer = [&](){
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                auto lock = std::unique_lock(mutex);
+                counter += 1;
+            }
+        };
+
+        auto a = std::thread(writer);
+        auto b = std::thread(writer);
+        a.join();
+        b.join();
+
+        auto lock = std::shared_lock(mutex);
+        Test::assert_that(counter == 20000);
     });
 
     Test::test("Task<T>: schedule/join", []()
@@ -1482,6 +1934,745 @@ int main()
         Test::assert_that((bool)task_proxy["sticky"] == false);
     });
 
+    Test::test("Future: then", []()
+    {
+        auto task = ThreadPool::create<size_t()>([]() -> size_t { return 4; });
+        auto squared = task.result().then([](const size_t& x) -> size_t { return x * x; });
+        auto as_string = squared.then([](const size_t& x) -> std::string { return std::to_string(x); });
+        auto failed = task.result().then([](const size_t&) -> size_t { throw std::runtime_error(""); });
+
+        task.schedule();
+
+        Test::assert_that(as_string.wait().value() == "16");
+        Test::assert_that(not failed.wait().has_value());
+        Test::assert_that(failed.is_failed());
+
+        // continuation registered after the value is available
+        auto late = task.result().then([](const size_t& x) { return x + 1; });
+        Test::assert_that(late.wait().value() == 5);
+
+        // the value is available, so then would call into Julia from a thread that may not do so
+        bool threw = false;
+        std::thread([&](){
+            try
+            {
+                auto _ = task.result().then([](const size_t& x) { return x; });
+            }
+            catch (std::runtime_error&)
+            {
+                threw = true;
+            }
+        }).join();
+        Test::assert_that(threw);
+    });
+
+    Test::test("Future: task throws", []()
+    {
+        auto task = ThreadPool::create<size_t()>([]() -> size_t { throw std::runtime_error(""); });
+        auto next = task.result().then([](const size_t& x) -> size_t { return x; });
+
+        task.schedule();
+
+        Test::assert_that(not task.result().wait().has_value());
+        Test::assert_that(task.result().is_failed());
+        Test::assert_that(not next.wait().has_value());
+
+        std::vector<std::function<size_t()>> callables = {
+            []() -> size_t { return 1; },
+            []() -> size_t { throw std::runtime_error(""); }
+        };
+
+        auto group = ThreadPool::spawn_batch(callables);
+        group.wait_all();
+        Test::assert_that(group.result(0).get().value() == 1);
+        Test::assert_that(group.result(1).is_failed());
+    });
+
+    Test::test("Future: when_all", []()
+    {
+        auto a = ThreadPool::create<size_t()>([]() -> size_t { return 1; });
+        auto b = ThreadPool::create<std::string()>([]() -> std::string { return "abc"; });
+
+        auto both = when_all(a.result(), b.result());
+
+        std::vector<Task<size_t>> tasks;
+        std::vector<Future<size_t>> futures;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            tasks.push_back(ThreadPool::create<size_t(size_t)>([](size_t i) -> size_t { return i; }, i));
+            futures.push_back(tasks.back().result());
+        }
+
+        auto all = when_all(futures);
+
+        a.schedule();
+        b.schedule();
+        for (auto& task : tasks)
+            task.schedule();
+
+        auto both_value = both.wait().value();
+        Test::assert_that(std::get<0>(both_value) == 1 and std::get<1>(both_value) == "abc");
+
+        auto all_value = all.wait().value();
+        for (size_t i = 0; i < all_value.size(); ++i)
+            Test::assert_that(all_value.at(i) == i);
+    });
+
+    Test::test("Future: when_any", []()
+    {
+        auto a = ThreadPool::create<size_t()>([]() -> size_t { return 1; });
+        auto b = ThreadPool::create<size_t()>([]() -> size_t { return 2; });
+
+        auto any = when_any(a.result(), b.result());
+        b.schedule();
+
+        auto value = any.wait().value();
+        Test::assert_that(value.first == 1 and value.second == 2);
+
+        a.schedule();
+        a.join();
+
+        Test::assert_that_throws<std::invalid_argument>([](){
+            auto _ = when_any(std::vector<Future<size_t>>());
+        });
+    });
+
+    Test::test("coroutine: co_await", []()
+    {
+        std::promise<size_t> promise;
+        auto future = promise.get_future();
+
+        [](std::promise<size_t>& promise) -> DetachedCoroutine
+        {
+            size_t a = co_await jluna::async([](size_t x) -> size_t { return x * 2; }, size_t(21));
+
+            auto task = ThreadPool::create<size_t()>([]() -> size_t { return 1; });
+            size_t b = co_await task;
+
+            co_await jluna::async([]() {});
+            promise.set_value(a + b);
+        }(promise);
+
+        Test::assert_that(future.get() == 43);
+    });
+
+    Test::test("coroutine: co_await from C++-side thread", []()
+    {
+        bool threw = false;
+        std::thread([&](){
+            try
+            {
+                auto task = jluna::async([]() -> size_t { return 1; });
+            }
+            catch (std::runtime_error&)
+            {
+                threw = true;
+            }
+        }).join();
+        Test::assert_that(threw);
+
+        if (not ThreadGuard::is_supported())
+            return;
+
+        std::promise<std::pair<size_t, std::thread::id>> promise;
+        auto future = promise.get_future();
+        std::thread::id awaiting_thread;
+
+        auto thread = std::thread([&](){
+            auto guard = ThreadGuard();
+            awaiting_thread = std::this_thread::get_id();
+
+            [](std::promise<std::pair<size_t, std::thread::id>>& promise) -> DetachedCoroutine
+            {
+                size_t a = co_await jluna::async([](size_t x) -> size_t { return x * 2; }, size_t(21));
+                promise.set_value({a, std::this_thread::get_id()});
+            }(promise);
+        });
+        thread.join();
+
+        auto result = future.get();
+        Test::assert_that(result.first == 42);
+
+        // continues on a Julia worker, not on the thread that awaited
+        Test::assert_that(result.second != awaiting_thread);
+    });
+
+    Test::test("Channel", []()
+    {
+        Test::assert_that_throws<std::invalid_argument>([](){
+            Channel<size_t> channel(0);
+        });
+
+        Channel<size_t> channel(4);
+        Test::assert_that(channel.capacity() == 4);
+
+        for (size_t i = 0; i < 4; ++i)
+            Test::assert_that(channel.try_push(i));
+
+        Test::assert_that(not channel.try_push(4));
+        Test::assert_that(channel.size() == 4);
+
+        auto popped = channel.pop_n(3);
+        Test::assert_that(popped.size() == 3 and popped.at(0) == 0 and popped.at(2) == 2);
+        Test::assert_that(channel.try_pop().value() == 3);
+        Test::assert_that(not channel.try_pop().has_value());
+
+        // producers and consumers on different threads
+        const size_t n = 1000;
+        std::vector<size_t> values(n);
+        for (size_t i = 0; i < n; ++i)
+            values.at(i) = i;
+
+        auto producer = std::thread([&](){
+            channel.push_n(values);
+            channel.close();
+        });
+
+        std::atomic<size_t> sum = 0;
+        auto consumer = std::thread([&](){
+            while (auto value = channel.pop())
+                sum += value.value();
+        });
+
+        producer.join();
+        consumer.join();
+
+        Test::assert_that(sum == n * (n - 1) / 2);
+        Test::assert_that(channel.is_closed());
+        Test::assert_that(not channel.push(1));
+        Test::assert_that(channel.pop_n(10).empty());
+    });
+
+    Test::test("Channel: Julia-side view", []()
+    {
+        Channel<Int64> channel(4);
+        auto* view = (unsafe::Value*) channel;
+        Test::assert_that(view == (unsafe::Value*) channel);
+
+        static auto* put = unsafe::get_function(jl_base_module, "put!"_sym);
+        jluna::safe_call(put, view, jl_box_int64(12));
+        Test::assert_that(channel.try_pop().value() == 12);
+
+        // consumer task yields while the channel is empty and is woken by the C++-side producer
+        const Int64 n = 1000;
+        auto producer = std::thread([&](){
+            for (Int64 i = 0; i < n; ++i)
+                channel.push(i);
+            channel.close();
+        });
+
+        auto* consume = jl_eval_string("return c -> fetch(Threads.@spawn sum(c))");
+        auto sum = unbox<Int64>(jluna::safe_call(consume, view));
+        producer.join();
+
+        Test::assert_that(sum == n * (n - 1) / 2);
+
+        static auto* isopen = unsafe::get_function(jl_base_module, "isopen"_sym);
+        Test::assert_that(not unbox<bool>(jluna::safe_call(isopen, view)));
+        Test::assert_that_throws<JuliaException>([&](){
+            jluna::safe_call(put, view, jl_box_int64(1));
+        });
+    });
+
+    Test::test("ThreadGuard", []()
+    {
+        // main thread already is a Julia thread, guard has no effect
+        {
+            auto guard = ThreadGuard();
+            Test::assert_that(ThreadGuard::is_julia_thread());
+        }
+
+        bool is_julia_thread_before = true;
+        bool threw = false;
+        Int64 result = 0;
+
+        auto thread = std::thread([&](){
+            is_julia_thread_before = ThreadGuard::is_julia_thread();
+            try
+            {
+                auto guard = ThreadGuard();
+
+                // adopted thread may have a higher id than any thread present at initialization
+                result = Main.safe_eval(R"(
+                    x = Ref(1)
+                    jluna.gc_sentinel.gc_push(pointer_from_objref(x))
+                    jluna.gc_sentinel.gc_pop()
+                    return x[] + 1
+                )");
+            }
+            catch (std::runtime_error&)
+            {
+                threw = true;
+            }
+        });
+        thread.join();
+
+        Test::assert_that(not is_julia_thread_before);
+        if (ThreadGuard::is_supported())
+            Test::assert_that(not threw and result == 2);
+        else
+            Test::assert_that(threw);
+    });
+
+    Test::test("CancellationToken", []()
+    {
+        // runs until cancelled, never yields
+        auto* spin = (unsafe::Function*) Main.safe_eval(R"(
+            return function(n)
+                i = 0
+                while true
+                    jluna.check_cancelled()
+                    i += n
+                end
+                return i
+            end
+        )");
+
+        auto token = CancellationToken();
+        Test::assert_that(not token.is_cancelled());
+
+        auto* add = (unsafe::Function*) Main.safe_eval("return +");
+        Test::assert_that(unbox<Int64>(call_with_token(token, add, box<Int64>(1), box<Int64>(2))) == 3);
+
+        token.cancel();
+        Test::assert_that(token.is_cancelled());
+        Test::assert_that_throws<CancellationException>([&](){
+            call_with_token(token, spin, box<Int64>(1));
+        });
+
+        auto copy = token;
+        Test::assert_that(copy.is_cancelled());
+
+        auto assigned = CancellationToken();
+        {
+            auto source = CancellationToken();
+            assigned = source;
+            Test::assert_that(not source.is_cancelled());
+
+            source.cancel();
+            Test::assert_that(assigned.is_cancelled());
+        }
+
+        Main.safe_eval("GC.gc()");
+        Test::assert_that(assigned.is_cancelled());
+        Test::assert_that_throws<CancellationException>([&](){
+            call_with_token(assigned, spin, box<Int64>(1));
+        });
+
+        auto deadline = CancellationToken();
+        deadline.cancel_after(std::chrono::hours(1));
+        Test::assert_that(not deadline.is_cancelled());
+        deadline.cancel_after(std::chrono::nanoseconds(0));
+        Test::assert_that(deadline.is_cancelled());
+
+        // other exceptions are not cancellations
+        Test::assert_that_throws<JuliaException>([](){
+            Main.safe_eval("throw(ErrorException(\"\"))");
+        });
+
+        bool is_cancellation = false;
+        try
+        {
+            Main.safe_eval("throw(ErrorException(\"\"))");
+        }
+        catch (const CancellationException&)
+        {
+            is_cancellation = true;
+        }
+        catch (const JuliaException&)
+        {}
+        Test::assert_that(not is_cancellation);
+    });
+
+    Test::test("call_with_deadline", []()
+    {
+        auto* spin = (unsafe::Function*) Main.safe_eval(R"(
+            return function()
+                while true
+                    jluna.check_cancelled()
+                end
+            end
+        )");
+
+        auto start = std::chrono::steady_clock::now();
+        Test::assert_that_throws<CancellationException>([&](){
+            call_with_deadline(std::chrono::milliseconds(10), spin);
+        });
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        Test::assert_that(elapsed >= std::chrono::milliseconds(10));
+        Test::assert_that(elapsed < std::chrono::seconds(5));
+
+        auto* identity = (unsafe::Function*) Main.safe_eval("return identity");
+        Test::assert_that(unbox<Int64>(call_with_deadline(std::chrono::seconds(10), identity, box<Int64>(1234))) == 1234);
+    });
+
+    Test::test("Task: cancel", []()
+    {
+        // cancelled before it started, the C++-side function is never invoked
+        std::atomic<bool> invoked = false;
+        auto not_started = ThreadPool::create<size_t()>([&]() -> size_t {
+            invoked = true;
+            return 1;
+        });
+
+        Test::assert_that(not_started.cancel());
+        Test::assert_that(not_started.result().is_failed());
+
+        not_started.schedule();
+        Test::assert_that_throws<CancellationException>([&](){
+            not_started.join();
+        });
+        Test::assert_that(not invoked);
+
+        // cancelled while running, the function observes it cooperatively
+        std::atomic<bool> started = false;
+        auto running = ThreadPool::create<void()>([&](){
+            started = true;
+            while (not jluna::is_cancelled())
+                jluna::yield();
+        });
+
+        running.schedule();
+        while (not started)
+            jluna::yield();
+
+        Test::assert_that(running.cancel());
+        running.join();
+        Test::assert_that(not running.result().wait().has_value());
+
+        // already done
+        auto done = ThreadPool::create<size_t()>([]() -> size_t { return 1; });
+        done.schedule();
+        done.join();
+        Test::assert_that(not done.cancel());
+        Test::assert_that(done.result().get().value() == 1);
+    });
+
+    Test::test("ThreadPool: pools", []()
+    {
+        Test::assert_that(ThreadPool::n_threads(ThreadPoolKind::DEFAULT) >= 1);
+
+        auto before = ThreadPool::get_stats(ThreadPoolKind::INTERACTIVE);
+        Test::assert_that(before.n_threads == ThreadPool::n_threads(ThreadPoolKind::INTERACTIVE));
+
+        // falls back to the default pool if there are no interactive threads, and is counted there
+        auto actual = before.n_threads > 0 ? ThreadPoolKind::INTERACTIVE : ThreadPoolKind::DEFAULT;
+        auto before_actual = ThreadPool::get_stats(actual);
+
+        auto task = ThreadPool::create<size_t()>(ThreadPoolKind::INTERACTIVE, [actual]() -> size_t {
+            return ThreadPool::get_stats(actual).n_running;
+        });
+        Test::assert_that(ThreadPool::get_stats(actual).n_queued == before_actual.n_queued);
+
+        task.schedule();
+        task.join();
+        Test::assert_that(task.result().get().value() == before_actual.n_running + 1);
+
+        auto after = ThreadPool::get_stats(actual);
+        Test::assert_that(after.n_running == before_actual.n_running);
+        Test::assert_that(after.n_queued == before_actual.n_queued);
+
+        if (actual == ThreadPoolKind::DEFAULT)
+        {
+            auto after_interactive = ThreadPool::get_stats(ThreadPoolKind::INTERACTIVE);
+            Test::assert_that(after_interactive.n_running == 0 and after_interactive.n_queued == 0);
+        }
+    });
+
+    Test::test("Executor", []()
+    {
+        Test::assert_that_throws<std::invalid_argument>([](){
+            Executor executor(1, 0);
+        });
+
+        auto executor = Executor(2, 16);
+        Test::assert_that(executor.n_workers() == 2);
+
+        // submit from C++-side threads that are unknown to Julia
+        std::vector<std::thread> threads;
+        std::vector<std::vector<Future<Int64>>> futures(4);
+
+        for (size_t t = 0; t < futures.size(); ++t)
+            threads.emplace_back([&, t](){
+                for (size_t i = 0; i < 100; ++i)
+                    futures.at(t).push_back(executor.submit([i]() -> Int64 {
+                        return Main.safe_eval("return " + std::to_string(i) + " * 2");
+                    }));
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        for (auto& per_thread : futures)
+            for (size_t i = 0; i < per_thread.size(); ++i)
+                Test::assert_that(per_thread.at(i).wait().value() == Int64(i * 2));
+
+        auto failed = executor.submit([]() -> size_t { throw std::runtime_error(""); });
+        Test::assert_that(not failed.wait().has_value());
+
+        auto batched = executor.make_batched<size_t, size_t>([](const std::vector<size_t>& in) {
+            std::vector<size_t> out;
+            for (auto x : in)
+                out.push_back(x + 1);
+            return out;
+        });
+
+        std::vector<Future<size_t>> batched_futures;
+        for (size_t i = 0; i < 10; ++i)
+            batched_futures.push_back(batched.submit(i));
+
+        for (size_t i = 0; i < batched_futures.size(); ++i)
+            Test::assert_that(batched_futures.at(i).wait().value() == i + 1);
+
+        // workers are parked after being idle, the next submit wakes them
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::optional<Future<Int64>> after_idle;
+        std::thread([&](){
+            after_idle = executor.submit([]() -> Int64 { return 1234; });
+        }).join();
+        Test::assert_that(after_idle.value().wait().value() == 1234);
+
+        auto metrics = executor.get_metrics();
+        Test::assert_that(metrics.n_submitted == 412);
+        Test::assert_that(metrics.n_completed <= metrics.n_submitted);
+        Test::assert_that(metrics.n_batches >= 1 and metrics.n_batches <= 10);
+        Test::assert_that(metrics.max_queue_depth <= 16);
+        Test::assert_that(metrics.max_latency >= metrics.mean_latency);
+    });
+
+    Test::test("Executor: submit from Julia task while full", []()
+    {
+        auto executor = Executor(1, 2);
+        const size_t n = 64;
+
+        // the submitter blocks on the full queue while the worker allocates and runs the GC
+        auto task = ThreadPool::create<size_t()>([&]() -> size_t {
+            std::vector<Future<Int64>> futures;
+            for (size_t i = 0; i < n; ++i)
+                futures.push_back(executor.submit([i]() -> Int64 {
+                    return Main.safe_eval("GC.gc(false); return length(collect(1:" + std::to_string(i) + "))");
+                }));
+
+            size_t sum = 0;
+            for (auto& future : futures)
+            {
+                while (not future.is_available() and not future.is_failed())
+                    jluna::yield();
+
+                sum += future.get().value();
+            }
+            return sum;
+        });
+
+        task.schedule();
+        task.join();
+        Test::assert_that(task.result().get().value() == n * (n - 1) / 2);
+    });
+
+    Test::test("ThreadPool: slot reuse", []()
+    {
+        for (size_t round = 0; round < 4; ++round)
+        {
+            std::vector<Task<size_t>> tasks;
+            for (size_t i = 0; i < 300; ++i)
+                tasks.push_back(ThreadPool::create<size_t(size_t)>([](size_t x) -> size_t { return x * x; }, i));
+
+            for (auto& task : tasks)
+                task.schedule();
+
+            for (size_t i = 0; i < tasks.size(); ++i)
+            {
+                tasks.at(i).join();
+                Test::assert_that(tasks.at(i).result().get().value() == i * i);
+            }
+        }
+
+        // closure too large to be stored inline
+        std::array<size_t, 64> large;
+        large.fill(1);
+
+        auto task = ThreadPool::create<size_t()>([large]() -> size_t {
+            size_t sum = 0;
+            for (auto x : large)
+                sum += x;
+            return sum;
+        });
+
+        task.schedule();
+        task.join();
+        Test::assert_that(task.result().get().value() == 64);
+    });
+
+    Test::test("ThreadPool: spawn_batch", []()
+    {
+        std::vector<std::function<size_t()>> callables;
+        for (size_t i = 0; i < 100; ++i)
+            callables.push_back([i]() -> size_t { return i + 1; });
+
+        auto group = ThreadPool::spawn_batch(callables);
+        Test::assert_that(group.size() == 100);
+
+        group.wait_all();
+        Test::assert_that(group.is_done());
+
+        for (size_t i = 0; i < group.size(); ++i)
+            Test::assert_that(group.result(i).get().value() == i + 1);
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            group.result(100);
+        });
+
+        std::atomic<size_t> n_called = 0;
+        std::vector<std::function<void()>> void_callables(10, [&]() { n_called += 1; });
+
+        auto void_group = ThreadPool::spawn_batch(void_callables);
+        void_group.wait_all();
+        Test::assert_that(n_called == 10);
+
+        auto empty = ThreadPool::spawn_batch(std::vector<std::function<void()>>());
+        empty.wait_all();
+        Test::assert_that(empty.size() == 0 and empty.is_done());
+    });
+
+    Test::test("parallel_for", []()
+    {
+        std::vector<size_t> out(1000, 0);
+        parallel_for({0, out.size()}, 16, [&](size_t i){
+            out.at(i) = i;
+        });
+
+        for (size_t i = 0; i < out.size(); ++i)
+            Test::assert_that(out.at(i) == i);
+
+        std::atomic<size_t> n_chunks = 0;
+        parallel_for({10, 20}, 3, [&](size_t first, size_t last){
+            Test::assert_that(last - first <= 3);
+            n_chunks += 1;
+        });
+        Test::assert_that(n_chunks == 4);
+
+        Test::assert_that_throws<std::invalid_argument>([](){
+            parallel_for({0, 100}, 1, [](size_t i){
+                if (i == 50)
+                    throw std::invalid_argument("");
+            });
+        });
+    });
+
+    Test::test("parallel_reduce", []()
+    {
+        auto sum = parallel_reduce({1, 1001}, size_t(0),
+            [](size_t accumulator, size_t i) { return accumulator + i; },
+            [](size_t a, size_t b) { return a + b; }
+        );
+        Test::assert_that(sum == 500500);
+
+        auto empty = parallel_reduce({5, 5}, Int64(-1),
+            [](Int64 accumulator, size_t i) { return accumulator + Int64(i); },
+            [](Int64 a, Int64 b) { return a + b; }
+        );
+        Test::assert_that(empty == -1);
+    });
+
+    Test::test("kernels: reductions", []()
+    {
+        Main.safe_eval("kernel_a = rand(Float64, 100003); kernel_b = rand(Float64, 100003)");
+        Array<Float64, 1> a = Main["kernel_a"];
+        Array<Float64, 1> b = Main["kernel_b"];
+
+        auto is_approx = [](Float64 x, std::string julia_expression) -> bool {
+            return Main.safe_eval("return isapprox(" + std::to_string(x) + ", " + julia_expression + ", rtol = 1e-6)");
+        };
+
+        auto before = kernels::get_instruction_set();
+        for (auto instruction_set : {kernels::InstructionSet::SCALAR, kernels::InstructionSet::AVX2, kernels::InstructionSet::AVX512})
+        {
+            if (not kernels::is_supported(instruction_set))
+                continue;
+
+            kernels::set_instruction_set(instruction_set);
+            for (bool use_threadpool : {false, true})
+            {
+                Test::assert_that(is_approx(kernels::sum(a, use_threadpool), "sum(kernel_a)"));
+                Test::assert_that(is_approx(kernels::dot(a, b, use_threadpool), "sum(kernel_a .* kernel_b)"));
+                Test::assert_that(is_approx(kernels::norm(a, use_threadpool), "sqrt(sum(kernel_a .^ 2))"));
+                Test::assert_that(kernels::minimum(a, use_threadpool) == Main.safe_eval("return minimum(kernel_a)").operator Float64());
+                Test::assert_that(kernels::maximum(a, use_threadpool) == Main.safe_eval("return maximum(kernel_a)").operator Float64());
+            }
+        }
+        kernels::set_instruction_set(before);
+
+        Test::assert_that_throws<std::invalid_argument>([](){
+            Array<Float64, 1> empty = Main.safe_eval("return Float64[]");
+            kernels::minimum(empty);
+        });
+    });
+
+    Test::test("kernels: axpy", []()
+    {
+        Main.safe_eval("kernel_x = Float32[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]; kernel_y = ones(Float32, 10)");
+        Array<Float32, 1> x = Main["kernel_x"];
+        Array<Float32, 1> y = Main["kernel_y"];
+
+        kernels::axpy(2.f, x, y);
+        Main.safe_eval("@assert kernel_y == 2 .* kernel_x .+ 1");
+
+        Array<Float32, 1> too_short = Main.safe_eval("return Float32[1]");
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            kernels::axpy(2.f, too_short, y);
+        });
+    });
+
+    Test::test("kernels: histogram", []()
+    {
+        Array<Float64, 2> array = Main.safe_eval("return reshape([0.0, 0.5, 1.0, 1.5, 2.5, 3.0, -1.0, NaN], 2, 4)");
+
+        auto counts = kernels::histogram(array, 3, 0.0, 3.0);
+        Test::assert_that(counts.size() == 3);
+        Test::assert_that(counts.at(0) == 2 and counts.at(1) == 2 and counts.at(2) == 1);
+
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            kernels::histogram(array, 0, 0.0, 1.0);
+        });
+    });
+
+    Test::test("broadcast: fused arithmetic", []()
+    {
+        Main.safe_eval("broadcast_a = [1.0, 2.0, 3.0]; broadcast_b = [4.0, 5.0, 6.0]; broadcast_c = zeros(3)");
+        Vector<Float64> a = Main["broadcast_a"];
+        Vector<Float64> b = Main["broadcast_b"];
+        Vector<Float64> c = Main["broadcast_c"];
+
+        auto expression = a * 2.0 + b;
+        Test::assert_that(decltype(expression)::get_shape() == "(+).((*).(x1, x2), x3)");
+
+        materialize(c, expression);
+        Main.safe_eval("@assert broadcast_c == broadcast_a .* 2.0 .+ broadcast_b");
+
+        materialize(c, jluna::max(a - b / 2, -a) + jluna::min(a, 2));
+        Main.safe_eval("@assert broadcast_c == max.(broadcast_a .- broadcast_b ./ 2, .-broadcast_a) .+ min.(broadcast_a, 2)");
+
+        Vector<Float64> allocated = materialize(a + b);
+        Test::assert_that(allocated.get_n_elements() == 3 and (Float64) allocated.at(0) == 5.0);
+        Main.safe_eval("@assert broadcast_a == [1.0, 2.0, 3.0]");
+    });
+
+    Test::test("broadcast: function", []()
+    {
+        Main.safe_eval("broadcast_a = [1.0, 4.0, 9.0]; broadcast_b = zeros(3)");
+        Vector<Float64> a = Main["broadcast_a"];
+        Vector<Float64> b = Main["broadcast_b"];
+
+        materialize(b, jluna::broadcast(Base["sqrt"], a) * 2);
+        Main.safe_eval("@assert broadcast_b == [2.0, 4.0, 6.0]");
+
+        Test::assert_that_throws<JuliaException>([&](){
+            Vector<Float64> too_short = Main.safe_eval("return [1.0]");
+            materialize(too_short, a + b);
+        });
+    });
+
     return Test::conclude() ? 0 : 1;
 }
 
@@ -0,0 +1,59 @@
+#
+# Build a Julia system image that already contains the jluna module, used by the jluna_sysimage target of jluna/CMakeLists.txt
+#
+# usage: julia --startup-file=no jluna_sysimage.jl <path to jluna.jl> <output path> <precompile file or ""> [packages...]
+#
+
+if length(ARGS) < 3
+    println(stderr, "usage: julia jluna_sysimage.jl <path to jluna.jl> <output path> <precompile file or \"\"> [packages...]")
+    exit(1)
+end
+
+const jluna_source_path = abspath(ARGS[1])
+const output_path = abspath(ARGS[2])
+const precompile_file = isempty(ARGS[3]) ? nothing : abspath(ARGS[3])
+const packages = Symbol.(ARGS[4:end])
+
+if Base.find_package("PackageCompiler") === nothing
+    println(stderr, "[JULIA][ERROR] building the jluna sysimage requires PackageCompiler.jl, install it using `julia -e \"import Pkg; Pkg.add(\\\"PackageCompiler\\\")\"`")
+    exit(1)
+end
+
+import PackageCompiler
+
+# evaluated while the image is created, loads jluna into Main exactly like jluna::initialize does,
+# then exercises the functions every jluna program calls, such that they are compiled into the image
+const workload = """
+    include_string(Main, read($(repr(jluna_source_path)), String))
+
+    # checked by jluna::initialize, which only reuses this module if the source matches
+    Core.eval(Main.jluna, :(const _image_source_hash = \$(hash(read($(repr(jluna_source_path)), String)))))
+
+    let value = [1, 2, 3]
+        Main.jluna.safe_call(identity, value)
+        Main.jluna.safe_call(getindex, value, 1)
+        Main.jluna.unroll_type(Int64)
+        Main.jluna.unroll_type(Vector{Int64})
+
+        GC.@preserve value begin
+            key = Main.jluna.memory_handler.create_reference(pointer_from_objref(value))
+            Main.jluna.memory_handler.get_reference(key)
+            Main.jluna.memory_handler.free_reference(key)
+        end
+        Main.jluna.memory_handler._current_id[] = 0
+    end
+"""
+
+const workload_path = tempname() * ".jl"
+write(workload_path, workload)
+
+try
+    PackageCompiler.create_sysimage(
+        packages;
+        sysimage_path = output_path,
+        script = workload_path,
+        precompile_execution_file = precompile_file === nothing ? String[] : [precompile_file]
+    )
+finally
+    rm(workload_path; force = true)
+end
@@ -9,17 +9,93 @@
 #include <include/proxy.hpp>
 #include <include/generator_expression.hpp>
 
+#include <cstring>
+#include <iterator>
+
 namespace jluna
 {
     template<is_boxable T>
     class Vector;
 
+    template<is_boxable T>
+    class ArrayView;
+
+    /// @brief tag type, selects all indices along a dimension, equivalent to Julia-side `:`
+    struct All {};
+
+    /// @brief instance of jluna::All, used as argument to Array::slice
+    inline constexpr All all = All();
+
+    /// @brief index specifier for one dimension of Array::slice
+    class Slice
+    {
+        template<is_boxable, size_t>
+        friend class Array;
+
+        public:
+            /// @brief select a single index, the dimension is dropped from the resulting view, implicit
+            /// @param index: 0-based
+            template<typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+            Slice(T index);
+
+            /// @brief select all indices along the dimension, implicit
+            Slice(All);
+
+            /// @brief select half-open range [first, last)
+            /// @param first: 0-based, inclusive
+            /// @param last: 0-based, exclusive
+            template<typename T, typename U, std::enable_if_t<std::is_integral_v<T> and std::is_integral_v<U>, bool> = true>
+            Slice(T first, U last);
+
+            /// @brief select every step-th index in half-open range [first, last)
+            /// @param first: 0-based, inclusive
+            /// @param last: 0-based, exclusive
+            /// @param step: stride, has to be positive
+            template<typename T, typename U, typename V, std::enable_if_t<std::is_integral_v<T> and std::is_integral_v<U> and std::is_integral_v<V>, bool> = true>
+            Slice(T first, U last, V step);
+
+        private:
+            enum Kind : Int64
+            {
+                SCALAR = 0,
+                ALL = 1,
+                RANGE = 2
+            };
+
+            Kind _kind;
+            Int64 _first;
+            Int64 _last;
+            Int64 _step;
+    };
+
+    namespace detail
+    {
+        template<size_t>
+        using slice_argument_t = Slice;
+
+        // expands to Array_t::slice(Slice, ..., Slice) with exactly Rank arguments, such that brace-initialization of each argument is possible
+        template<typename Array_t, typename Value_t, typename Index_sequence>
+        struct SliceableArray;
+
+        template<typename Array_t, typename Value_t, size_t... Is>
+        struct SliceableArray<Array_t, Value_t, std::index_sequence<Is...>>
+        {
+            /// @brief create a view, does not invoke a copy
+            /// @param slices: one index specifier per dimension, either an index, jluna::all, {first, last} or {first, last, step}
+            /// @returns view of Julia-side type Base.SubArray, sharing storage with the array
+            ArrayView<Value_t> slice(slice_argument_t<Is>... slices) const;
+        };
+    }
+
     /// @brief wrapper for julia-side Array{Value_t, Rank}
     /// @tparam Value_t: boxable value ype
     /// @tparam Rank: rank of the array
     template<is_boxable Value_t, size_t Rank>
-    class Array : public Proxy
+    class Array : public Proxy, public detail::SliceableArray<Array<Value_t, Rank>, Value_t, std::make_index_sequence<Rank>>
     {
+        template<typename, typename, typename>
+        friend struct detail::SliceableArray;
+
         public:
             friend class ConstIterator;
             class Iterator;
@@ -64,6 +140,7 @@ namespace jluna
             /// @brief julia-style list indexing
             /// @param range: iterable range with indices
             /// @returns new array, result of Julia-side getindex(this, range)
+            /// @note this invokes a copy, use Array::slice to create a view instead
             jluna::Vector<Value_t> operator[](const std::vector<size_t>& range) const;
 
             /// @brief julia-style list indexing
@@ -158,6 +235,8 @@ namespace jluna
             /// @returns void pointer
             void* data();
 
+            using detail::SliceableArray<Array<Value_t, Rank>, Value_t, std::make_index_sequence<Rank>>::slice;
+
         protected:
             using Proxy::_content;
 
@@ -165,6 +244,8 @@ namespace jluna
             void throw_if_index_out_of_range(int index, size_t dimension) const;
             size_t get_dimension(int) const;
 
+            ArrayView<Value_t> make_view(const std::vector<Slice>&) const;
+
         public:
             /// @brief non-assignable iterator
             class ConstIterator
@@ -285,10 +366,26 @@ namespace jluna
             /// @param value: new value
             void insert(size_t pos, Value_t value);
 
+            /// @brief insert all elements of a range, grows the array only once
+            /// @param pos: linear index, 0-based, the first inserted element will be at this position
+            /// @param range: iterable range whose value type is convertible to Value_t
+            template<Iterable Range_t> requires std::is_convertible_v<typename Range_t::value_type, Value_t>
+            void insert(size_t pos, const Range_t& range);
+
             /// @brief erase at specified position
             /// @param pos: linear index, 0-based
             void erase(size_t pos);
 
+            /// @brief erase all elements in half-open range [first, last)
+            /// @param first: linear index, 0-based, inclusive
+            /// @param last: linear index, 0-based, exclusive
+            void erase(size_t first, size_t last);
+
+            /// @brief add all elements of a range to the back, grows the array only once
+            /// @param range: iterable range whose value type is convertible to Value_t
+            template<Iterable Range_t> requires std::is_convertible_v<typename Range_t::value_type, Value_t>
+            void append(const Range_t& range);
+
             /// @brief add to front
             /// @tparam T: type of value, not necessarily the same as the declared array type
             /// @param value: new value
@@ -306,6 +403,102 @@ namespace jluna
 
         protected:
             using Array<Value_t, 1>::_content;
+
+        private:
+            // can elements be written to Julia-side memory directly, without boxing
+            bool is_memory_compatible() const;
+
+            // write all elements of range to data, starting at 0-based offset, assumes enough memory was allocated
+            template<typename Range_t>
+            void copy_to_data(const Range_t& range, size_t offset);
+
+            // box all elements of range into Julia-side Vector{Any}
+            template<typename Range_t>
+            unsafe::Array* box_range(const Range_t& range);
+    };
+
+    /// @brief view into an array, wrapper for julia-side Base.SubArray{Value_t}
+    /// @note the view shares storage with its parent array, no elements are copied unless ArrayView::copy is called
+    template<is_boxable Value_t>
+    class ArrayView : public Proxy
+    {
+        template<is_boxable, size_t>
+        friend class Array;
+
+        public:
+            /// @brief value type
+            using value_type = Value_t;
+
+            /// @brief construct from Julia-side SubArray, parent has to be an Array, indices have to be integers or ranges
+            /// @param value: pointer to Julia-side SubArray
+            /// @param symbol: name of Julia-side variable, or nullptr for anonymous variable
+            ArrayView(unsafe::Value* value, jl_sym_t* symbol = nullptr);
+
+            /// @brief construct as child of already existing proxy, implicit
+            /// @param proxy: pointer to already created proxy
+            ArrayView(Proxy*);
+
+            /// @brief linear indexing, column-major, relative to the view
+            /// @param index: 0-based
+            /// @returns unboxed value
+            template<is_unboxable T = Value_t>
+            T operator[](size_t) const;
+
+            /// @brief multi-dimensional indexing, relative to the view
+            /// @param n: get_rank()-many integers
+            /// @returns unboxed value
+            template<is_unboxable T = Value_t, typename... Args, std::enable_if_t<(std::is_integral_v<Args> and ...), bool> = true>
+            T at(Args... in) const;
+
+            /// @brief assign a value using a linear index, modifies the parent array
+            /// @param index: linear index relative to the view, 0-based
+            /// @param value: new value
+            template<is_boxable T = Value_t>
+            void set(size_t i, T);
+
+            /// @brief get number of elements in the view
+            /// @returns size_t
+            size_t get_n_elements() const;
+
+            /// @brief get number of dimensions of the view, scalar-indexed dimensions of the parent are dropped
+            /// @returns size_t
+            size_t get_rank() const;
+
+            /// @brief get size in specific dimension
+            /// @param dimension_index: 0-based
+            /// @returns size_t
+            size_t size(size_t dimension_index) const;
+
+            /// @brief is empty
+            /// @returns true if the view has no elements, false otherwise
+            bool empty() const;
+
+            /// @brief get the array this view shares storage with
+            /// @returns pointer to Julia-side array
+            unsafe::Array* get_parent() const;
+
+            /// @brief explicitly copy all elements of the view into a newly allocated array
+            /// @tparam Rank: rank of the resulting array, has to be equal to get_rank()
+            /// @returns result of Julia-side Base.copy(this)
+            template<size_t Rank = 1>
+            [[nodiscard]] Array<Value_t, Rank> copy() const;
+
+            /// @brief cast to unsafe::Value*, implicit
+            using Proxy::operator unsafe::Value*;
+
+        protected:
+            using Proxy::_content;
+
+        private:
+            ArrayView(unsafe::Value* value, const std::vector<Int64>& slices);
+            void initialize(const std::vector<Int64>& slices);
+            size_t to_parent_index(size_t) const;
+
+            unsafe::Array* _parent;
+            Int64 _offset;
+            size_t _n_elements;
+            std::vector<size_t> _sizes;
+            std::vector<Int64> _strides;
     };
 
     ///@brief typedefs for Array{Any, 1}
@@ -322,4 +515,5 @@ namespace jluna
 }
 
 #include <.src/array.inl>
-#include <.src/array_iterator.inl>
\ No newline at end of file
+#include <.src/array_iterator.inl>
+#include <.src/array_view.inl>
\ No newline at end of file
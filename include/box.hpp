@@ -165,7 +165,7 @@ namespace jluna
     template<is_usertype T>
     unsafe::Value* box(T);
 
-    /// @brief box mutex to Base.ReentrantLock
+    /// @brief box mutex to jluna.Mutex
     class Mutex;
     template<is<Mutex> T>
     unsafe::Value* box(T);
@@ -181,13 +181,13 @@ namespace jluna
     };
 
     /// @brief forward function result
-    /// @param function
+    /// @param function: invoked in place, not copied
     /// @param args
     /// @returns jl_nothing if return_type is void, boxed value otherwise
     template<typename Function_t, typename... Args_t, std::enable_if_t<std::is_void_v<std::invoke_result_t<Function_t, Args_t...>>, bool> = true>
-    static unsafe::Value* box_function_result(Function_t f, Args_t... args);
+    static unsafe::Value* box_function_result(Function_t&& f, Args_t&&... args);
     template<typename Function_t, typename... Args_t, std::enable_if_t<not std::is_void_v<std::invoke_result_t<Function_t, Args_t...>>, bool> = true>
-    static unsafe::Value* box_function_result(Function_t f, Args_t... args);
+    static unsafe::Value* box_function_result(Function_t&& f, Args_t&&... args);
 }
 
 #include <.src/box.inl>
\ No newline at end of file
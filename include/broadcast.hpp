@@ -0,0 +1,185 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/array.hpp>
+
+#include <tuple>
+
+namespace jluna
+{
+    namespace detail
+    {
+        // operation tags, julia_name is used as `julia_name.(args...)`
+        struct BroadcastPlus { static constexpr const char* julia_name = "(+)"; };
+        struct BroadcastMinus { static constexpr const char* julia_name = "(-)"; };
+        struct BroadcastTimes { static constexpr const char* julia_name = "(*)"; };
+        struct BroadcastDivide { static constexpr const char* julia_name = "(/)"; };
+        struct BroadcastMin { static constexpr const char* julia_name = "min"; };
+        struct BroadcastMax { static constexpr const char* julia_name = "max"; };
+
+        // user-supplied function, which is the first argument of the expression
+        struct BroadcastCall {};
+
+        // leaf that is already Julia-side: an array or a function
+        struct BroadcastValueLeaf
+        {
+            static constexpr size_t n_leaves = 1;
+
+            static void write_shape(std::stringstream&, size_t&);
+
+            template<size_t N>
+            void collect(std::array<unsafe::Value*, N>&, size_t&) const;
+
+            unsafe::Value* _value;
+        };
+
+        // C++-side scalar, boxed on evaluation
+        template<typename T>
+        struct BroadcastScalarLeaf
+        {
+            static constexpr size_t n_leaves = 1;
+
+            static void write_shape(std::stringstream&, size_t&);
+
+            template<size_t N>
+            void collect(std::array<unsafe::Value*, N>&, size_t&) const;
+
+            T _value;
+        };
+
+        template<typename T>
+        struct is_broadcast_array : std::false_type {};
+
+        template<is_boxable V, size_t R>
+        struct is_broadcast_array<Array<V, R>> : std::true_type {};
+
+        template<is_boxable V>
+        struct is_broadcast_array<Vector<V>> : std::true_type {};
+
+        template<is_boxable V>
+        struct is_broadcast_array<ArrayView<V>> : std::true_type {};
+
+        template<typename T>
+        struct is_broadcast_expression : std::false_type {};
+    }
+
+    /// @brief lazy, fused element-wise expression over arrays, created by applying +, -, *, /, jluna::min, jluna::max or jluna::broadcast to jluna::Array, jluna::Vector or jluna::ArrayView
+    /// @note the expression references its array operands, it should not outlive them
+    template<typename Op_t, typename... Args_t>
+    class BroadcastExpression
+    {
+        template<typename, typename...>
+        friend class BroadcastExpression;
+
+        public:
+            /// @brief number of Julia-side arguments of the fused kernel
+            static constexpr size_t n_leaves = (Args_t::n_leaves + ...);
+
+            /// @brief ctor, use the operators instead
+            /// @param args: operands
+            BroadcastExpression(Args_t... args);
+
+            /// @brief evaluate into an already allocated destination, equivalent to Julia-side `destination .= expression`
+            /// @param destination: jluna::Array, jluna::Vector or jluna::ArrayView
+            template<typename Destination_t>
+            void materialize_into(Destination_t& destination) const;
+
+            /// @brief evaluate into a newly allocated array, equivalent to Julia-side `Base.materialize(expression)`
+            /// @returns unnamed proxy to the result
+            [[nodiscard]] Proxy materialize() const;
+
+            /// @brief the Julia-side broadcast expression, where argument i is named `x{i}`
+            /// @returns expression as string, for example `(+).((*).(x1, x2), x3)`
+            static std::string get_shape();
+
+        private:
+            static void write_shape(std::stringstream&, size_t&);
+
+            template<typename... Ts>
+            static void write_list(std::stringstream&, size_t&);
+
+            template<size_t N>
+            void collect(std::array<unsafe::Value*, N>&, size_t&) const;
+
+            // kernel is compiled once per expression type
+            static unsafe::Function* get_kernel(bool in_place);
+
+            // returns proxy to result if Destination_t is void, nothing otherwise
+            template<typename Destination_t>
+            auto evaluate(Destination_t* destination) const;
+
+            std::tuple<Args_t...> _args;
+    };
+
+    namespace detail
+    {
+        template<typename Op_t, typename... Args_t>
+        struct is_broadcast_expression<BroadcastExpression<Op_t, Args_t...>> : std::true_type {};
+    }
+
+    /// @concept: jluna::Array, jluna::Vector, jluna::ArrayView or jluna::BroadcastExpression
+    template<typename T>
+    concept is_broadcastable = detail::is_broadcast_array<std::remove_cvref_t<T>>::value or detail::is_broadcast_expression<std::remove_cvref_t<T>>::value;
+
+    /// @concept: valid operand of a broadcast expression, either broadcastable or an arithmetic scalar
+    template<typename T>
+    concept is_broadcast_operand = is_broadcastable<T> or std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+    /// @brief element-wise a + b, lazy
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator+(const A& a, const B& b);
+
+    /// @brief element-wise a - b, lazy
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator-(const A& a, const B& b);
+
+    /// @brief element-wise a * b, lazy
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator*(const A& a, const B& b);
+
+    /// @brief element-wise a / b, lazy
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto operator/(const A& a, const B& b);
+
+    /// @brief element-wise -a, lazy
+    template<is_broadcastable A>
+    auto operator-(const A& a);
+
+    /// @brief element-wise Base.min, lazy
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto min(const A& a, const B& b);
+
+    /// @brief element-wise Base.max, lazy
+    template<is_broadcast_operand A, is_broadcast_operand B> requires (is_broadcastable<A> or is_broadcastable<B>)
+    auto max(const A& a, const B& b);
+
+    /// @brief element-wise application of a Julia-side function, lazy, equivalent to Julia-side `f.(args...)`
+    /// @param f: Julia-side function, for C++-side functions, use jluna::as_julia_function
+    /// @param args: operands, at least one has to be broadcastable
+    template<is_broadcast_operand... Args_t> requires (is_broadcastable<Args_t> or ...)
+    auto broadcast(unsafe::Function* f, const Args_t&... args);
+
+    /// @brief element-wise application of a Julia-side function, lazy, equivalent to Julia-side `f.(args...)`
+    /// @param f: proxy to Julia-side function
+    /// @param args: operands, at least one has to be broadcastable
+    template<is_broadcast_operand... Args_t> requires (is_broadcastable<Args_t> or ...)
+    auto broadcast(const Proxy& f, const Args_t&... args);
+
+    /// @brief evaluate expression into destination, equivalent to Julia-side `destination .= expression`
+    /// @param destination: jluna::Array, jluna::Vector or jluna::ArrayView
+    /// @param expression: broadcast expression
+    template<typename Destination_t, typename Op_t, typename... Args_t> requires detail::is_broadcast_array<Destination_t>::value
+    void materialize(Destination_t& destination, const BroadcastExpression<Op_t, Args_t...>& expression);
+
+    /// @brief evaluate expression into a newly allocated array
+    /// @param expression: broadcast expression
+    /// @returns unnamed proxy to the result
+    template<typename Op_t, typename... Args_t>
+    [[nodiscard]] Proxy materialize(const BroadcastExpression<Op_t, Args_t...>& expression);
+}
+
+#include <.src/broadcast.inl>
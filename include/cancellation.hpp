@@ -0,0 +1,85 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/safe_utilities.hpp>
+
+#include <chrono>
+
+namespace jluna
+{
+    /// @brief flag requesting cooperative cancellation of a Julia-side computation, boxes to the Julia-side jluna.CancellationToken.
+    /// Julia code observes the token through `jluna.is_cancelled()` or `jluna.check_cancelled()`, the latter throws an InterruptException,
+    /// which is forwarded to C++ as a jluna::CancellationException
+    /// @note cancellation is cooperative, a computation that never checks the token runs to completion
+    class CancellationToken
+    {
+        public:
+            /// @brief construct, not cancelled and without deadline
+            CancellationToken();
+
+            /// @brief copy ctor, the copy refers to the same token
+            /// @param other
+            CancellationToken(const CancellationToken&);
+
+            /// @brief copy assignment, afterwards both refer to the same token
+            /// @param other
+            /// @returns reference to self
+            CancellationToken& operator=(const CancellationToken&);
+
+            /// @brief destruct
+            ~CancellationToken();
+
+            /// @brief request cancellation, thread-safe and does not call into Julia, such that it may be called from any thread
+            void cancel();
+
+            /// @brief request cancellation once timeout has passed, thread-safe and does not call into Julia
+            /// @param timeout: duration after which the token counts as cancelled, measured from now
+            void cancel_after(std::chrono::nanoseconds timeout);
+
+            /// @brief was cancellation requested or did the deadline pass
+            /// @returns bool
+            bool is_cancelled() const;
+
+            /// @brief get julia-side jluna.CancellationToken
+            /// @returns value
+            operator unsafe::Value*() const;
+
+        private:
+            unsafe::Value* _value;
+            size_t _value_id;
+
+            // jluna.CancellationToken._state, 1 if cancelled, 0 otherwise
+            uint32_t* _state;
+
+            // jluna.CancellationToken._deadline, in nanoseconds of jl_hrtime()
+            uint64_t* _deadline;
+    };
+
+    /// @brief call function with args, such that `jluna.is_cancelled()` and `jluna.check_cancelled()` observe the token while it is running
+    /// @param token: cancellation token
+    /// @param function: function
+    /// @param args: arguments, need to be already Julia-side
+    /// @returns result
+    /// @throws CancellationException if the function was cancelled, JuliaException if it threw otherwise
+    template<is_julia_value_pointer... Args_t>
+    unsafe::Value* call_with_token(const CancellationToken& token, unsafe::Function* function, Args_t... args);
+
+    /// @brief call function with args, cancelling it once timeout has passed
+    /// @param timeout: maximum duration of the call
+    /// @param function: function, has to regularly call `jluna.check_cancelled()`
+    /// @param args: arguments, need to be already Julia-side
+    /// @returns result
+    /// @throws CancellationException if the deadline passed, JuliaException if the function threw otherwise
+    template<is_julia_value_pointer... Args_t>
+    unsafe::Value* call_with_deadline(std::chrono::nanoseconds timeout, unsafe::Function* function, Args_t... args);
+
+    /// @brief is the current Julia-side task cancelled, either through jluna::Task::cancel or through the token of an enclosing call_with_token
+    /// @returns bool
+    bool is_cancelled();
+}
+
+#include <.src/cancellation.inl>
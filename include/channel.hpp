@@ -0,0 +1,145 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/concepts.hpp>
+#include <include/typedefs.hpp>
+#include <include/safe_utilities.hpp>
+
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <vector>
+
+namespace jluna
+{
+    namespace detail
+    {
+        // type-erased interface used by the Julia-side jluna.CppChannel, see jluna_channel_push and jluna_channel_pop in .src/c_adapter.hpp
+        struct ChannelInterface
+        {
+            virtual ~ChannelInterface() = default;
+
+            // 1 if the element was pushed, 2 if the channel is closed, 0 if it is full, in which case the calling Julia task counts as waiting until the next call
+            virtual int julia_push(const void* value, bool was_waiting) = 0;
+
+            // 1 if an element was popped, 2 if the channel is closed and empty, 0 if it is empty, in which case the calling Julia task counts as waiting until the next call
+            virtual int julia_pop(void* out, bool was_waiting) = 0;
+
+            virtual void close() = 0;
+            virtual bool is_closed() const = 0;
+            virtual size_t size() const = 0;
+        };
+    }
+
+    /// @brief bounded, thread-safe multi-producer multi-consumer queue, used to pass values between C++ threads and Julia tasks.
+    /// For isbits T, the channel can be handed to Julia, where it is a jluna.CppChannel{T} <: AbstractChannel{T}, supporting put!, take!, close, isopen, isready and iteration.
+    /// Julia tasks waiting on it yield to the Julia scheduler and are woken once C++ pushes, pops or closes the channel
+    /// @note blocking operations block the calling thread, but allow the garbage collector to run while waiting. Julia tasks should use the Julia-side view, or try_push and try_pop in combination with jluna::yield, such that the Julia thread can execute other tasks in the meantime
+    template<typename T>
+    class Channel : public detail::ChannelInterface
+    {
+        public:
+            /// @brief ctor
+            /// @param capacity: maximum number of elements, has to be at least 1
+            /// @throws std::invalid_argument if capacity is 0
+            Channel(size_t capacity);
+
+            /// @brief copy ctor deleted
+            Channel(const Channel&) = delete;
+
+            /// @brief copy assignment deleted
+            Channel& operator=(const Channel&) = delete;
+
+            /// @brief dtor, closes the Julia-side view, if any. Julia code may not use the view once the channel is destroyed
+            ~Channel();
+
+            /// @brief get Julia-side view, a jluna.CppChannel{T}. The elements are not copied, Julia and C++ operate on the same buffer
+            /// @returns value, the same for every call
+            operator unsafe::Value*() requires is_native_function_type<T>;
+
+            /// @brief add an element, blocks while the channel is full
+            /// @param value
+            /// @returns true if the element was added, false if the channel was closed
+            bool push(T value);
+
+            /// @brief add an element if there is space
+            /// @param value
+            /// @returns true if the element was added, false if the channel is full or closed
+            bool try_push(T value);
+
+            /// @brief add multiple elements, blocks until all were added. Elements are added in as few lock acquisitions as capacity allows
+            /// @param values: range of elements
+            /// @returns number of elements added, less than the number of values if the channel was closed in the meantime
+            template<Iterable Range_t>
+            size_t push_n(const Range_t& values);
+
+            /// @brief remove the oldest element, blocks while the channel is empty
+            /// @returns element, or no value if the channel is closed and empty
+            std::optional<T> pop();
+
+            /// @brief remove the oldest element, if there is one
+            /// @returns element, or no value if the channel is empty
+            std::optional<T> try_pop();
+
+            /// @brief remove up to n elements in a single lock acquisition, blocks until at least one element is available
+            /// @param n: maximum number of elements
+            /// @returns elements, oldest first. Empty if the channel is closed and empty
+            std::vector<T> pop_n(size_t n);
+
+            /// @brief close the channel, pending and future push operations fail, pop operations succeed until the channel is empty
+            void close() override;
+
+            /// @brief is the channel closed
+            /// @returns true if close() was called, false otherwise
+            bool is_closed() const override;
+
+            /// @brief get number of elements currently in the channel
+            /// @returns number
+            size_t size() const override;
+
+            /// @brief get maximum number of elements
+            /// @returns number
+            size_t capacity() const;
+
+        private:
+            void push_locked(T&&);
+            T pop_locked();
+
+            // block until predicate holds, returns with lock held. On Julia threads, waits in a GC-safe region, which is never left while holding the lock
+            template<typename Predicate_t>
+            void wait(std::condition_variable&, std::unique_lock<std::mutex>&, Predicate_t);
+
+            // wake Julia tasks waiting on the view, may be called from any thread
+            void notify_julia();
+
+            int julia_push(const void* value, bool was_waiting) override;
+            int julia_pop(void* out, bool was_waiting) override;
+
+            mutable std::mutex _mutex;
+            std::condition_variable _not_full;
+            std::condition_variable _not_empty;
+
+            // ring buffer, _size elements starting at _head
+            std::vector<std::optional<T>> _buffer;
+            size_t _head = 0;
+            size_t _size = 0;
+            bool _closed = false;
+
+            // Julia-side jluna.CppChannel, nullptr until requested
+            unsafe::Value* _view = nullptr;
+            size_t _view_id = 0;
+
+            // uv_async_t handle of the views Base.AsyncCondition, and uv_async_send, which is thread-safe
+            void* _async_handle = nullptr;
+            int (*_async_send)(void*) = nullptr;
+
+            // number of Julia tasks waiting on the view
+            size_t _n_julia_waiters = 0;
+    };
+}
+
+#include <.src/channel.inl>
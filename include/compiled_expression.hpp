@@ -0,0 +1,85 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/proxy.hpp>
+
+#include <string>
+#include <vector>
+
+namespace jluna
+{
+    /// @brief Julia code that is parsed and lowered once, such that it can be evaluated repeatedly without re-parsing it, unlike safe_eval
+    class CompiledExpression
+    {
+        public:
+            /// @brief ctor, parse and lower code. Evaluating the expression behaves like `safe_eval(code, module)`, except that all statements are lowered together as one block
+            /// @note because macros are expanded during lowering, a macro cannot be defined and used in the same code, unlike with safe_eval
+            /// @param code: Julia code, may contain multiple lines
+            /// @param module: module the code is evaluated in
+            /// @throws JuliaException if the code cannot be parsed or lowered
+            CompiledExpression(const std::string& code, unsafe::Module* module = jl_main_module);
+
+            /// @brief ctor, compile code into a function taking the given parameters, equivalent to `(parameters...) -> begin code end`.
+            /// Evaluating the expression calls this function, which is compiled on first evaluation
+            /// @param code: Julia code, may contain multiple lines. Assignments create local variables unless they are marked `global`
+            /// @param parameters: names of the parameters, bound to the arguments of each evaluation
+            /// @param module: module the code is evaluated in
+            /// @throws JuliaException if the code cannot be parsed or lowered
+            CompiledExpression(const std::string& code, const std::vector<std::string>& parameters, unsafe::Module* module = jl_main_module);
+
+            /// @brief copy ctor, the copy shares the compiled code
+            /// @param other
+            CompiledExpression(const CompiledExpression&);
+
+            /// @brief copy assignment, afterwards both share the compiled code
+            /// @param other
+            /// @returns reference to self
+            CompiledExpression& operator=(const CompiledExpression&);
+
+            /// @brief dtor
+            ~CompiledExpression();
+
+            /// @brief evaluate
+            /// @param args: arguments, one per parameter, have to be boxable
+            /// @returns unnamed proxy to the result
+            /// @throws std::invalid_argument if the number of arguments does not match the number of parameters, JuliaException if the evaluation throws
+            template<is_boxable... Args_t>
+            Proxy operator()(Args_t&&... args) const;
+
+            /// @brief evaluate and return value, does not construct proxy
+            /// @tparam T: type of the result, if void, the result is discarded
+            /// @param args: arguments, one per parameter, have to be boxable
+            /// @returns result
+            /// @throws std::invalid_argument if the number of arguments does not match the number of parameters, JuliaException if the evaluation throws
+            template<typename T, is_boxable... Args_t>
+            T evaluate(Args_t&&... args) const;
+
+            /// @brief get number of parameters
+            /// @returns number
+            size_t n_parameters() const;
+
+            /// @brief get code the expression was compiled from
+            /// @returns string
+            const std::string& get_code() const;
+
+        private:
+            template<is_julia_value_pointer... Args_t>
+            unsafe::Value* safe_evaluate(Args_t... args) const;
+
+            void throw_if_wrong_number_of_arguments(size_t) const;
+
+            std::string _code;
+            unsafe::Module* _module;
+            size_t _n_parameters;
+
+            // lowered toplevel thunk if there are no parameters, compiled function otherwise
+            unsafe::Value* _value;
+            size_t _value_id;
+    };
+}
+
+#include <.src/compiled_expression.inl>
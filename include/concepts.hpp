@@ -178,6 +178,21 @@ namespace jluna
         is<T, std::string> or
         is<T, const char*>;
 
+    /// @concept isbits type that has the same memory layout in C++ and Julia, can be passed through ccall without boxing
+    template<typename T>
+    concept is_native_function_type =
+        is<T, bool> or
+        is<T, uint8_t> or
+        is<T, uint16_t> or
+        is<T, uint32_t> or
+        is<T, uint64_t> or
+        is<T, int8_t> or
+        is<T, int16_t> or
+        is<T, int32_t> or
+        is<T, int64_t> or
+        is<T, float> or
+        is<T, double>;
+
     /// @concept is std::complex
     template<typename T>
     concept is_complex = requires(T t)
@@ -0,0 +1,68 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/multi_threading.hpp>
+#include <include/thread_guard.hpp>
+
+#include <coroutine>
+
+namespace jluna
+{
+    /// @brief awaiter for a jluna::Task, the awaiting coroutine is resumed once the Julia-side task is done, without blocking a thread
+    /// @note awaiting calls into Julia, so the awaiting thread has to be a Julia thread, C++-side threads have to hold a jluna::ThreadGuard.
+    /// The coroutine is resumed from within a new Julia-side task, on a Julia worker thread rather than the thread that awaited, so after co_await it may safely interact with the Julia state
+    template<typename Result_t>
+    class TaskAwaiter
+    {
+        public:
+            /// @brief ctor, use co_await instead
+            /// @param task: task, has to stay valid until the coroutine is resumed
+            TaskAwaiter(Task<Result_t>& task);
+
+            /// @brief is the task already done, if yes, the coroutine is not suspended
+            /// @returns true if done, false otherwise
+            bool await_ready();
+
+            /// @brief schedule the task if it was not yet scheduled, then register the coroutine to be resumed once it is done
+            /// @param handle: coroutine handle
+            /// @throws std::runtime_error if the current thread is not a Julia thread
+            void await_suspend(std::coroutine_handle<> handle);
+
+            /// @brief access the tasks result
+            /// @returns value, nothing if Result_t is void
+            /// @throws JuliaException if the task failed
+            Result_t await_resume();
+
+        private:
+            Task<Result_t>* _task;
+    };
+
+    /// @brief await a task, schedules it if it was not yet scheduled
+    /// @param task: task
+    /// @returns awaiter, co_await yields the tasks result
+    template<typename Result_t>
+    TaskAwaiter<Result_t> operator co_await(Task<Result_t>& task);
+
+    /// @brief await a temporary task, schedules it. The task lives until the end of the co_await expression
+    /// @param task: task
+    /// @returns awaiter, co_await yields the tasks result
+    template<typename Result_t>
+    TaskAwaiter<Result_t> operator co_await(Task<Result_t>&& task);
+
+    /// @brief create a task invoking f with args, to be used as `co_await jluna::async(f, args...)`
+    /// @param f: function or lambda
+    /// @param args: arguments, copied into the task
+    /// @returns task, not yet scheduled, it is scheduled once it is awaited
+    /// @throws std::runtime_error if the current thread is not a Julia thread, C++-side threads have to hold a jluna::ThreadGuard
+    template<typename Function_t,
+        typename... Args_t,
+        typename Result_t = std::invoke_result_t<Function_t, Args_t...>
+    >
+    [[nodiscard]] Task<Result_t> async(Function_t f, Args_t... args);
+}
+
+#include <.src/coroutine.inl>
@@ -7,43 +7,95 @@
 
 #include <include/typedefs.hpp>
 #include <functional>
+#include <span>
 
 namespace jluna
 {
+    namespace detail
+    {
+        // each argument is handed to the C++-side function as a Julia-side object
+        template<typename>
+        using as_value_pointer_t = unsafe::Value*;
+
+        // owns a C++-side function, Julia-side jluna.cppcall.UnnamedFunction invokes and deallocates it through the static member functions.
+        // These are instantiated once per signature and have C-compatible signatures, such that Julia can ccall them directly with one argument per parameter
+        template<typename Function_t, typename... Args_t>
+        struct CppFunction
+        {
+            Function_t _function;
+
+            static unsafe::Value* invoke(void* self, as_value_pointer_t<Args_t>... args);
+            static void free(void* self);
+        };
+
+        // Julia-side type declared for an argument or the result of a C++-side function. Only types whose boxed value always has exactly
+        // this Julia-side type are declared, all others are declared as Any
+        template<typename T>
+        unsafe::Value* as_declared_type();
+
+        // Signature_t is only used to deduce the return and argument types
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        unsafe::Value* make_julia_function(Function_t f, Return_t(*)(Args_t...));
+
+        // owns a C++-side function with an isbits signature, Julia-side jluna.cppcall.NativeFunction ccalls invoke with the native argument types,
+        // such that neither the arguments nor the result are boxed
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        struct NativeFunction
+        {
+            Function_t _function;
+
+            static Return_t invoke(void* self, Args_t... args);
+            static void free(void* self);
+        };
+
+        template<typename Function_t, typename Return_t, typename... Args_t>
+        unsafe::Value* make_native_function(Function_t f, Return_t(*)(Args_t...));
+
+        // owns a vectorized C++-side function, Julia-side jluna.cppcall.BatchFunction ccalls invoke once per dense array,
+        // handing it pointers to the input and output buffers
+        template<typename Function_t, typename In_t, typename Out_t>
+        struct BatchFunction
+        {
+            Function_t _function;
+
+            static void invoke(void* self, const In_t* in, Out_t* out, size_t n);
+            static void free(void* self);
+        };
+    }
+
     /// @brief make lambda available to Julia
-    /// @tparam Signature: signature of lambda, C-style
+    /// @tparam Signature: signature of lambda, C-style, may have any number of arguments
     /// @tparam Lambda_t: automatically deduced
     /// @returns unsafe pointer to Julia-side function object
     template<typename Signature, typename Lambda_t>
     unsafe::Value* as_julia_function(Lambda_t lambda);
 
-    /// @brief make function with signature () -> Return_t available to julia
+    /// @brief make function with signature (Args_t...) -> Return_t available to julia
     /// @tparam Return_t: return type of lambda, may be `void`
+    /// @tparam Args_t: argument types, has to be unboxable
     /// @param function: lambda
     /// @returns unsafe pointer to Julia-side function object
-    template<typename Return_t>
-    unsafe::Value* register_function(std::function<Return_t()>);
+    template<typename Return_t, typename... Args_t>
+    unsafe::Value* register_function(std::function<Return_t(Args_t...)> f);
 
-    /// @brief make function with signature (T1) -> Return_t available to julia
-    /// @tparam Return_t: return type of lambda, may be `void`
-    /// @param function: lambda
-    /// @returns unsafe pointer to Julia-side function object
-    template<typename Return_t, typename Arg1_t>
-    unsafe::Value* register_function(std::function<Return_t(Arg1_t)> f);
-
-    /// @brief make function with signature (T1, T2) -> Return_t available to julia
-    /// @tparam Return_t: return type of lambda, may be `void`
-    /// @param function: lambda
-    /// @returns unsafe pointer to Julia-side function object
-    template<typename Return_t, typename Arg1_t, typename Arg2_t>
-    unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t)> f);
+    /// @brief make lambda with an isbits signature available to Julia. Julia-side, the function is invoked with a single ccall using the native argument types, no value is boxed
+    /// @tparam Signature: signature of lambda, C-style. The return type has to be void or fulfill is_native_function_type, all argument types have to fulfill is_native_function_type
+    /// @tparam Lambda_t: automatically deduced
+    /// @returns unsafe pointer to Julia-side jluna.cppcall.NativeFunction. Julia-side arguments are converted to the argument types of the signature
+    /// @note the lambda should not throw, as C++ exceptions cannot propagate through Julia-side frames
+    template<typename Signature, typename Lambda_t>
+    unsafe::Value* register_native_function(Lambda_t lambda);
 
-    /// @brief make function with signature (T1, T2, T3) -> Return_t available to julia
-    /// @tparam Return_t: return type of lambda, may be `void`
-    /// @param function: lambda
-    /// @returns unsafe pointer to Julia-side function object
-    template<typename Return_t, typename Arg1_t, typename Arg2_t, typename Arg3_t>
-    unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t, Arg3_t)> f);
+    /// @brief make vectorized lambda with signature (std::span<const In_t>, std::span<Out_t>) -> void available to Julia. Julia-side, broadcasting or mapping it over
+    /// a dense array with element type In_t invokes the lambda once for the entire array, otherwise it is invoked once per element with spans of size 1
+    /// @tparam In_t: element type of the input, has to fulfill is_native_function_type
+    /// @tparam Out_t: element type of the output, has to fulfill is_native_function_type
+    /// @tparam Lambda_t: automatically deduced
+    /// @param lambda: has to write out[i] for every in[i], both spans are of the same size
+    /// @returns unsafe pointer to Julia-side jluna.cppcall.BatchFunction
+    /// @note the lambda should not throw, as C++ exceptions cannot propagate through Julia-side frames
+    template<typename In_t, typename Out_t, typename Lambda_t>
+    unsafe::Value* register_batch_function(Lambda_t lambda);
 }
 
-#include <.src/cppcall.inl>
\ No newline at end of file
+#include <.src/cppcall.inl>
@@ -40,6 +40,14 @@ namespace jluna
             std::string _message;
     };
 
+    /// @brief exception thrown when a Julia-side computation was cancelled, either through a jluna::CancellationToken, a deadline or jluna::Task::cancel.
+    /// Julia-side, the computation was stopped by an InterruptException
+    class CancellationException : public JuliaException
+    {
+        public:
+            using JuliaException::JuliaException;
+    };
+
     /// @brief exception thrown when trying to use jluna or julia before initialization
     struct JuliaUninitializedException : public std::exception
     {
@@ -54,6 +62,12 @@ namespace jluna
     /// @brief if exception occurred, forward as JuliaException
     void forward_last_exception();
 
+    namespace detail
+    {
+        // throw as CancellationException if the exception was caused by a cancellation, as JuliaException otherwise
+        [[noreturn]] void throw_julia_exception(unsafe::Value* exception, const std::string& stacktrace);
+    }
+
     /// @brief throw if initialize was not yet called
     void throw_if_uninitialized();
 }
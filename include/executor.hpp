@@ -0,0 +1,226 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/multi_threading.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace jluna
+{
+    class Executor;
+
+    namespace detail
+    {
+        struct ExecutorBatchBase;
+
+        // node of the executors submission queue
+        struct ExecutorItem
+        {
+            virtual ~ExecutorItem() = default;
+
+            std::atomic<ExecutorItem*> next = nullptr;
+            std::chrono::steady_clock::time_point submitted;
+
+            // invoked for unbatched items, nullptr for batched items
+            TaskCallable callable;
+
+            // non-null for items of a batched function
+            ExecutorBatchBase* batch = nullptr;
+        };
+
+        // vectorized function, processes all queued items of the same batched function at once
+        struct ExecutorBatchBase
+        {
+            virtual ~ExecutorBatchBase() = default;
+            virtual void process(std::vector<ExecutorItem*>&) = 0;
+        };
+
+        // intrusive lock-free multi-producer single-consumer queue. Pushing never blocks, pop may only be called by one thread at a time
+        class ExecutorQueue
+        {
+            public:
+                ExecutorQueue();
+
+                // thread-safe
+                void push(ExecutorItem*);
+
+                // returns nullptr if empty, or if an element is currently being pushed
+                ExecutorItem* pop();
+
+            private:
+                ExecutorItem _stub;
+                std::atomic<ExecutorItem*> _head;
+                ExecutorItem* _tail;
+        };
+    }
+
+    /// @brief statistics of an executors queue
+    struct ExecutorMetrics
+    {
+        /// @brief number of work items accepted by submit or try_submit
+        size_t n_submitted;
+
+        /// @brief number of work items that finished executing, including failed ones
+        size_t n_completed;
+
+        /// @brief number of work items rejected by try_submit because the queue was full
+        size_t n_rejected;
+
+        /// @brief number of vectorized invocations of batched functions
+        size_t n_batches;
+
+        /// @brief number of work items currently queued or executing
+        size_t queue_depth;
+
+        /// @brief largest queue depth observed
+        size_t max_queue_depth;
+
+        /// @brief mean time between submission and completion
+        std::chrono::nanoseconds mean_latency;
+
+        /// @brief largest time between submission and completion
+        std::chrono::nanoseconds max_latency;
+    };
+
+    /// @brief function whose queued calls are merged into a single vectorized invocation, see Executor::make_batched
+    template<typename In_t, typename Out_t>
+    class BatchedFunction
+    {
+        friend class Executor;
+
+        public:
+            /// @brief queue a call, blocks while the executors queue is full
+            /// @param in: argument
+            /// @returns future holding the corresponding element of the vectorized result
+            Future<Out_t> submit(In_t in);
+
+        private:
+            struct Item;
+            struct Batch;
+
+            BatchedFunction(Executor*, std::function<std::vector<Out_t>(const std::vector<In_t>&)>);
+
+            Executor* _executor;
+            std::shared_ptr<Batch> _batch;
+    };
+
+    /// @brief pool of Julia-side worker tasks, executing C++-side work items submitted from arbitrary threads.
+    /// Items are queued in a lock-free multi-producer single-consumer queue, submitting never calls into Julia, such that C++-side threads that are unknown to Julia may use it safely
+    /// @note the executor has to be constructed and destroyed from a thread that may access the Julia state, usually the main thread
+    class Executor
+    {
+        template<typename, typename>
+        friend class BatchedFunction;
+
+        public:
+            /// @brief ctor, starts the worker tasks
+            /// @param n_workers: number of Julia-side worker tasks, if 0, ThreadPool::n_threads() is used
+            /// @param max_queue_size: maximum number of queued or executing items, submit blocks while it is reached
+            /// @param max_batch_size: maximum number of items a worker takes from the queue at once
+            /// @throws std::invalid_argument if max_queue_size or max_batch_size is 0
+            Executor(size_t n_workers = 0, size_t max_queue_size = 1024, size_t max_batch_size = 64);
+
+            /// @brief dtor, executes all remaining items, then stops the worker tasks
+            ~Executor();
+
+            /// @brief copy ctor deleted
+            Executor(const Executor&) = delete;
+
+            /// @brief copy assignment deleted
+            Executor& operator=(const Executor&) = delete;
+
+            /// @brief queue a work item, blocks while the queue is full
+            /// @param f: function with signature () -> T, may access the Julia state
+            /// @returns future holding the result, jl_nothing if T is void. Fails if f throws
+            template<typename Function_t,
+                typename T = std::invoke_result_t<Function_t>
+            >
+            Future<detail::as_future_value_t<T>> submit(Function_t f);
+
+            /// @brief queue a work item if the queue is not full
+            /// @param f: function with signature () -> T, may access the Julia state
+            /// @returns future holding the result, or no value if the queue is full
+            template<typename Function_t,
+                typename T = std::invoke_result_t<Function_t>
+            >
+            std::optional<Future<detail::as_future_value_t<T>>> try_submit(Function_t f);
+
+            /// @brief create a batched function. Calls to it that are queued at the same time are handed to f in a single invocation
+            /// @param f: vectorized function, has to return exactly one result per argument
+            /// @returns batched function, has to be destroyed before the executor
+            template<typename In_t, typename Out_t>
+            BatchedFunction<In_t, Out_t> make_batched(std::function<std::vector<Out_t>(const std::vector<In_t>&)> f);
+
+            /// @brief get statistics
+            /// @returns metrics
+            ExecutorMetrics get_metrics() const;
+
+            /// @brief get number of worker tasks
+            /// @returns number
+            size_t n_workers() const;
+
+            /// @brief take items from the queue and execute them, called by the Julia-side worker tasks. If the queue is empty, waits for a short time for new items
+            /// @returns 0 if no item arrived, in which case the worker waits on its Base.AsyncCondition until the next submit, 1 if items were executed, 2 if the executor was stopped and the queue is empty
+            int drain();
+
+        private:
+            // blocks while the queue is full, returns false if non-blocking and full
+            bool reserve(bool blocking);
+            void enqueue(detail::ExecutorItem*);
+            void complete(detail::ExecutorItem*);
+
+            // wait for new items in the gc-safe state, woken by enqueue through _sleep_cv. Returns false if none arrived before the timeout
+            bool wait_for_items();
+            static constexpr auto _idle_timeout = std::chrono::microseconds(500);
+
+            // called once wait_for_items timed out. Returns 0 if the worker should park on the Julia-side condition, which frees its thread for other Julia tasks, 1 if it should drain again
+            int park();
+
+            // wake all sleeping and parked workers
+            void wake_all();
+
+            detail::ExecutorQueue _queue;
+            std::mutex _consumer_mutex;
+
+            size_t _n_workers;
+            size_t _max_queue_size;
+            size_t _max_batch_size;
+
+            std::atomic<bool> _stopped = false;
+            std::atomic<size_t> _depth = 0;
+
+            // number of items pushed but not yet popped
+            std::atomic<size_t> _n_pending = 0;
+            std::atomic<size_t> _n_sleeping = 0;
+            std::mutex _sleep_mutex;
+            std::condition_variable _sleep_cv;
+
+            // number of workers waiting on the Julia-side Base.AsyncCondition, which is signalled through uv_async_send, which is thread-safe
+            std::atomic<size_t> _n_parked = 0;
+            void* _async_handle = nullptr;
+            int (*_async_send)(void*) = nullptr;
+
+            std::mutex _full_mutex;
+            std::condition_variable _full_cv;
+
+            std::atomic<size_t> _n_submitted = 0;
+            std::atomic<size_t> _n_completed = 0;
+            std::atomic<size_t> _n_rejected = 0;
+            std::atomic<size_t> _n_batches = 0;
+            std::atomic<size_t> _max_depth = 0;
+            std::atomic<uint64_t> _total_latency_ns = 0;
+            std::atomic<uint64_t> _max_latency_ns = 0;
+
+            // Julia-side Tuple{Vector{Task}, Base.AsyncCondition} of workers and the condition they park on
+            unsafe::Value* _workers = nullptr;
+            size_t _workers_id = 0;
+    };
+}
+
+#include <.src/executor.inl>
@@ -25,6 +25,34 @@ module jluna
         return (res, exception_occurred, exception, backtrace)
     end
 
+    """
+    `compile_expression(::Module, code::String, parameters::Vector{String}) -> Any`
+
+    parse code once. Without parameters, lower it, such that the result can be evaluated repeatedly using `Core.eval`.
+    Otherwise, evaluate it into a function `(parameters...) -> begin code end`
+    """
+    function compile_expression(m::Module, code::String, parameters::Vector{String})
+
+        parsed = Meta.parseall(code)
+        for arg in parsed.args
+            if arg isa Expr && (arg.head == :error || arg.head == :incomplete)
+                throw(Meta.ParseError(string(arg.args[1])))
+            end
+        end
+
+        body = Expr(:block, parsed.args...)
+
+        if isempty(parameters)
+            lowered = Meta.lower(m, body)
+            if lowered isa Expr && (lowered.head == :error || lowered.head == :incomplete)
+                throw(ErrorException(string(lowered.args[1])))
+            end
+            return lowered
+        else
+            return Core.eval(m, Expr(:->, Expr(:tuple, Symbol.(parameters)...), body))
+        end
+    end
+
     """
     `dot(::Array, field::Symbol) -> Any`
 
@@ -253,6 +281,68 @@ module jluna
         return T
     end
 
+    """
+    `make_view(::Array, ::Vector{Int64}) -> SubArray`
+
+    create view, each dimension is specified by four consecutive entries `(kind, first, length, step)`, where
+    kind is 0 for a scalar index, 1 for `:` and 2 for a range. `first` is 0-based
+    """
+    function make_view(array::Array, slices::Vector{Int64}) ::SubArray
+
+        indices = Vector{Any}(undef, div(length(slices), 4))
+
+        for i in 1:length(indices)
+            kind, first, n, step = slices[4*(i-1)+1], slices[4*(i-1)+2], slices[4*(i-1)+3], slices[4*(i-1)+4]
+
+            if kind == 0
+                indices[i] = first + 1
+            elseif kind == 1
+                indices[i] = Colon()
+            elseif step == 1
+                indices[i] = (first + 1):(first + n)
+            else
+                indices[i] = (first + 1):step:(first + 1 + (n - 1) * step)
+            end
+        end
+
+        return view(array, indices...)
+    end
+
+    """
+    `get_view_slices(::SubArray) -> Vector{Int64}`
+
+    inverse of make_view, throws if the view was not created from an Array using integer or range indices
+    """
+    function get_view_slices(x::SubArray{T, N, <:Array}) ::Vector{Int64} where {T, N}
+
+        out = Vector{Int64}()
+
+        for index in parentindices(x)
+            if index isa Integer
+                append!(out, (0, index - 1, 1, 1))
+            elseif index isa Base.Slice
+                append!(out, (1, 0, length(index), 1))
+            elseif index isa AbstractRange{<:Integer}
+                append!(out, (2, first(index) - 1, length(index), step(index)))
+            else
+                throw(ArgumentError("jluna.get_view_slices: unsupported index of type " * string(typeof(index))))
+            end
+        end
+
+        return out
+    end
+
+    """
+    `insert_range!(::Vector, ::Integer, ::Vector{Any}) -> Nothing`
+
+    insert all values into vector such that the first value is at 1-based index `pos`, converting them to the element type
+    """
+    function insert_range!(vector::Vector, pos::Integer, values::Vector{Any}) ::Nothing
+
+        splice!(vector, pos:(pos - 1), values)
+        return nothing
+    end
+
     """
     `new_vector(::Integer, ::T) -> Vector{T}`
 
@@ -362,10 +452,289 @@ module jluna
     end
 
     """
-    `new_lock() -> Base.ReentrantLock`
+    `Mutex`
+
+    lock shared with C++-side jluna::Mutex. Its state is a single atomic word,
+    `0` if unlocked, `1` if locked, `2` if locked and C++-side threads may be waiting
+    """
+    mutable struct Mutex <: Base.AbstractLock
+
+        _state::Threads.Atomic{UInt32}
+        Mutex() = new(Threads.Atomic{UInt32}(0))
+    end
+
+    const _mutex_n_spins = 128
+
+    """
+    `trylock(::jluna.Mutex) -> Bool`
+    """
+    function Base.trylock(m::Mutex) ::Bool
+        return Threads.atomic_cas!(m._state, UInt32(0), UInt32(1)) == 0
+    end
+
+    """
+    `lock(::jluna.Mutex) -> Nothing`
+
+    spin briefly, then yield to the scheduler until the lock is acquired
+    """
+    function Base.lock(m::Mutex) ::Nothing
+
+        for _ in 1:_mutex_n_spins
+            if Threads.atomic_cas!(m._state, UInt32(0), UInt32(1)) == 0
+                return nothing
+            end
+            ccall(:jl_cpu_pause, Cvoid, ())
+        end
+
+        while Threads.atomic_xchg!(m._state, UInt32(2)) != 0
+            yield()
+        end
+        return nothing
+    end
+
+    """
+    `unlock(::jluna.Mutex) -> Nothing`
+    """
+    function Base.unlock(m::Mutex) ::Nothing
+
+        if Threads.atomic_xchg!(m._state, UInt32(0)) == 2
+            ccall((:jluna_mutex_notify, cppcall._lib), Cvoid, (Ptr{UInt32},), pointer_from_objref(m._state))
+        end
+        return nothing
+    end
+
+    """
+    `islocked(::jluna.Mutex) -> Bool`
+    """
+    Base.islocked(m::Mutex) = m._state[] != 0
+
+    """
+    `new_lock() -> jluna.Mutex`
     """
     function new_lock()
-        return Base.ReentrantLock()
+        return Mutex()
+    end
+
+    """
+    `CppChannel{T} <: AbstractChannel{T}`
+
+    view of a C++-side jluna::Channel<T> for isbits `T`. Tasks that would block yield to the scheduler,
+    they are woken through `_cond` once C++ pushes, pops or closes the channel. `_cond` remembers notifications
+    sent while no task is waiting, so a wakeup between registering as waiting and calling `wait` is not lost
+    """
+    mutable struct CppChannel{T} <: AbstractChannel{T}
+
+        _ptr::Ptr{Cvoid}
+        _cond::Base.AsyncCondition
+        CppChannel{T}(ptr::Ptr{Cvoid}) where T = new{T}(ptr, Base.AsyncCondition())
+    end
+
+    """
+    `new_cpp_channel(::Type, ::Ptr{Cvoid}) -> jluna.CppChannel`
+    """
+    function new_cpp_channel(T::Type, ptr::Ptr{Cvoid})
+        return CppChannel{T}(ptr)
+    end
+
+    """
+    `get_async_handle(::jluna.CppChannel) -> Ptr{Cvoid}`
+    """
+    function get_async_handle(c::CppChannel) ::Ptr{Cvoid}
+        return c._cond.handle
+    end
+
+    """
+    `invalidate_cpp_channel(::jluna.CppChannel) -> Nothing`
+
+    called once the C++-side channel is destroyed, waiting tasks are woken and throw
+    """
+    function invalidate_cpp_channel(c::CppChannel) ::Nothing
+        c._ptr = C_NULL
+        close(c._cond)
+        return nothing
+    end
+
+    function _cpp_channel_ptr(c::CppChannel) ::Ptr{Cvoid}
+        if c._ptr == C_NULL
+            throw(InvalidStateException("C++-side channel was destroyed", :closed))
+        end
+        return c._ptr
+    end
+
+    function _cpp_channel_wait(c::CppChannel) ::Nothing
+        try
+            wait(c._cond)
+        catch e
+            e isa EOFError || rethrow()
+        end
+        return nothing
+    end
+
+    """
+    `put!(::jluna.CppChannel{T}, value) -> T`
+    """
+    function Base.put!(c::CppChannel{T}, value) where T
+
+        v = Ref{T}(convert(T, value))
+        was_waiting = Cint(0)
+        while true
+            status = ccall((:jluna_channel_push, cppcall._lib), Cint, (Ptr{Cvoid}, Ptr{T}, Cint), _cpp_channel_ptr(c), v, was_waiting)
+            if status == 1
+                return v[]
+            elseif status == 2
+                throw(InvalidStateException("Channel is closed.", :closed))
+            end
+            _cpp_channel_wait(c)
+            was_waiting = Cint(1)
+        end
+    end
+
+    """
+    `take!(::jluna.CppChannel{T}) -> T`
+    """
+    function Base.take!(c::CppChannel{T}) where T
+
+        out = Ref{T}()
+        was_waiting = Cint(0)
+        while true
+            status = ccall((:jluna_channel_pop, cppcall._lib), Cint, (Ptr{Cvoid}, Ptr{T}, Cint), _cpp_channel_ptr(c), out, was_waiting)
+            if status == 1
+                return out[]
+            elseif status == 2
+                throw(InvalidStateException("Channel is closed.", :closed))
+            end
+            _cpp_channel_wait(c)
+            was_waiting = Cint(1)
+        end
+    end
+
+    """
+    `close(::jluna.CppChannel) -> Nothing`
+    """
+    function Base.close(c::CppChannel) ::Nothing
+        ccall((:jluna_channel_close, cppcall._lib), Cvoid, (Ptr{Cvoid},), _cpp_channel_ptr(c))
+        return nothing
+    end
+
+    """
+    `isopen(::jluna.CppChannel) -> Bool`
+    """
+    function Base.isopen(c::CppChannel) ::Bool
+        return c._ptr != C_NULL && ccall((:jluna_channel_is_closed, cppcall._lib), Cint, (Ptr{Cvoid},), c._ptr) == 0
+    end
+
+    """
+    `isready(::jluna.CppChannel) -> Bool`
+    """
+    function Base.isready(c::CppChannel) ::Bool
+        return c._ptr != C_NULL && ccall((:jluna_channel_size, cppcall._lib), Csize_t, (Ptr{Cvoid},), c._ptr) > 0
+    end
+
+    """
+    `iterate(::jluna.CppChannel) -> Union{Tuple{T, Nothing}, Nothing}`
+
+    take elements until the channel is closed and empty
+    """
+    function Base.iterate(c::CppChannel, state = nothing)
+        try
+            return (take!(c), nothing)
+        catch e
+            if e isa InvalidStateException && e.state === :closed
+                return nothing
+            end
+            rethrow()
+        end
+    end
+
+    Base.IteratorSize(::Type{<:CppChannel}) = Base.SizeUnknown()
+
+    """
+    `CancellationToken`
+
+    cancellation flag shared with C++-side jluna::CancellationToken. `_state` is `1` if the token was cancelled, `0` otherwise,
+    `_deadline` is the value of `time_ns()` after which the token counts as cancelled
+    """
+    mutable struct CancellationToken
+
+        _state::Threads.Atomic{UInt32}
+        _deadline::Threads.Atomic{UInt64}
+        CancellationToken() = new(Threads.Atomic{UInt32}(0), Threads.Atomic{UInt64}(typemax(UInt64)))
+    end
+
+    """
+    `new_cancellation_token() -> jluna.CancellationToken`
+    """
+    function new_cancellation_token()
+        return CancellationToken()
+    end
+
+    """
+    `cancel(::jluna.CancellationToken) -> Nothing`
+    """
+    function cancel(token::CancellationToken) ::Nothing
+        token._state[] = 1
+        return nothing
+    end
+
+    """
+    `is_cancelled(::jluna.CancellationToken) -> Bool`
+    """
+    function is_cancelled(token::CancellationToken) ::Bool
+        return token._state[] != 0 || time_ns() >= token._deadline[]
+    end
+
+    """
+    `is_cancelled() -> Bool`
+
+    is the current task cancelled, either through the token handed to `with_cancellation_token` or through jluna::Task::cancel
+    """
+    function is_cancelled() ::Bool
+
+        storage = current_task().storage
+        if storage !== nothing
+            token = get(storage, :jluna_cancellation_token, nothing)
+            if token !== nothing && is_cancelled(token::CancellationToken)
+                return true
+            end
+        end
+
+        return cppcall.is_task_cancelled(current_task())
+    end
+
+    """
+    `check_cancelled() -> Nothing`
+
+    throw an `InterruptException` if the current task is cancelled. Long-running code should call this regularly,
+    as cancellation is cooperative: a computation that never checks cannot be cancelled
+    """
+    function check_cancelled() ::Nothing
+
+        if is_cancelled()
+            throw(InterruptException())
+        end
+        return nothing
+    end
+
+    """
+    `with_cancellation_token(::jluna.CancellationToken, f, args...) -> Any`
+
+    invoke `f(args...)`, such that `is_cancelled()` and `check_cancelled()` observe the token while `f` is running
+    """
+    function with_cancellation_token(token::CancellationToken, f, args...)
+
+        if is_cancelled(token)
+            throw(InterruptException())
+        end
+        return task_local_storage(() -> f(args...), :jluna_cancellation_token, token)
+    end
+
+    """
+    `is_cancellation(::Any) -> Bool`
+
+    is the exception caused by a cancellation, possibly wrapped in a `TaskFailedException`
+    """
+    function is_cancellation(e) ::Bool
+        return e isa InterruptException || (e isa TaskFailedException && is_cancellation(e.task.result))
     end
 
     module gc_sentinel
@@ -416,22 +785,55 @@ module jluna
 
         # ---
 
-        const _gc_stack = NTuple{Threads.nthreads(), List{Base.RefValue{Any}}}([List{Base.RefValue{Any}}() for i in 1:Threads.nthreads()])
+        # highest thread id, on Julia 1.9+ includes interactive threads
+        _max_thread_id() = isdefined(Threads, :maxthreadid) ? Threads.maxthreadid() : Threads.nthreads()
+
+        # one stack per thread id, replaced by a larger copy once a thread with a higher id, such as one adopted by jluna::ThreadGuard, pushes
+        mutable struct GCStacks
+            @atomic stacks::Vector{List{Base.RefValue{Any}}}
+        end
+
+        const _gc_stacks = GCStacks([List{Base.RefValue{Any}}() for _ in 1:_max_thread_id()])
+        const _gc_stacks_lock = Threads.SpinLock()
+
+        function _gc_stack(id::Integer) ::List{Base.RefValue{Any}}
+
+            stacks = @atomic _gc_stacks.stacks
+            if id <= length(stacks)
+                return stacks[id]
+            end
+
+            lock(_gc_stacks_lock)
+            try
+                stacks = @atomic _gc_stacks.stacks
+                if id > length(stacks)
+                    grown = copy(stacks)
+                    for _ in (length(stacks) + 1):max(id, _max_thread_id())
+                        push!(grown, List{Base.RefValue{Any}}())
+                    end
+                    @atomic _gc_stacks.stacks = grown
+                    stacks = grown
+                end
+            finally
+                unlock(_gc_stacks_lock)
+            end
+            return stacks[id]
+        end
 
         function gc_push(ptr::Ptr{Cvoid}) ::Nothing
-            append!(_gc_stack[Threads.threadid()], Ref{Any}(unsafe_pointer_to_objref(ptr)))
+            append!(_gc_stack(Threads.threadid()), Ref{Any}(unsafe_pointer_to_objref(ptr)))
             return nothing
         end
 
         function gc_pop() ::Nothing
-            pop!(_gc_stack[Threads.threadid()])
+            pop!(_gc_stack(Threads.threadid()))
         end
 
         function shutdown() ::Nothing
 
-            for i in 1:Threads.nthreads()
-                while !isempty(_gc_stack[i])
-                    pop!(_gc_stack[i])
+            for stack in @atomic _gc_stacks.stacks
+                while !isempty(stack)
+                    pop!(stack)
                 end
             end
             return nothing
@@ -701,25 +1103,25 @@ module jluna
         end
 
         """
-        object that is callable like a function, but executes C++-side code
+        object that is callable like a function, but executes C++-side code. Return_t is the declared type of the result,
+        Args_t a Tuple type whose elements are the declared types of the arguments
         """
-        mutable struct UnnamedFunction{NArgs}
+        mutable struct UnnamedFunction{Return_t, Args_t <: Tuple}
 
             _native_handle::Ptr{Cvoid}
-            # points to C-side function
+            # points to C++-side function object
 
-            _n_args::Cint
-            #  0: (void) -> Any
-            #  1: (Any) -> Any
-            #  2: (Any, Any) -> Any
-            #  3: (Any, Any, Any) -> Any
-            # all others invalid
+            _invoke::Ptr{Cvoid}
+            # (Ptr{Cvoid}, Any...) -> Any, takes the function object followed by exactly one argument per element of Args_t
 
-            function UnnamedFunction{N}(ptr::Ptr{Cvoid}) where N
+            _free::Ptr{Cvoid}
+            # (Ptr{Cvoid}) -> Cvoid, deallocates the function object
 
-                out = new{N}(ptr, N)
-                finalizer(function (t::UnnamedFunction{N})
-                    ccall((:jluna_free_lambda, cppcall._lib), Cvoid, (Csize_t, Cint), t._native_handle, t._n_args)
+            function UnnamedFunction{Return_t, Args_t}(handle::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}) where {Return_t, Args_t <: Tuple}
+
+                out = new{Return_t, Args_t}(handle, invoke, free)
+                finalizer(function (t::UnnamedFunction)
+                    ccall(t._free, Cvoid, (Ptr{Cvoid},), t._native_handle)
                 end, out);
 
                 return out;
@@ -727,93 +1129,370 @@ module jluna
         end
 
         """
-        `make_unnamed_function(::Ptr{Cvoid}, n::Integer) -> UnnamedFunction{n}
+        `make_unnamed_function(::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Type, ::Type{<:Tuple}) -> UnnamedFunction`
 
         wrapper for UnnamedFunction ctor
         """
-        function make_unnamed_function(ptr::Ptr{Cvoid}, n::Integer)
-            return UnnamedFunction{n}(ptr)
+        function make_unnamed_function(handle::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}, return_type::Type, arg_types::Type{<:Tuple})
+            return UnnamedFunction{return_type, arg_types}(handle, invoke, free)
         end
 
         """
-        `invoke_function(::UnnamedFunction) -> Ptr{Any}`
+        `UnnamedFunction(xs...) -> Return_t`
 
-        invoke function with 0 args
+        invoke UnnamedFunction. One ccall is generated per signature, each argument is passed as a separate
+        object reference, such that no intermediate collection is allocated. The result is asserted to be
+        of the declared return type, which makes calls type-stable
         """
-        function invoke_function(f::UnnamedFunction{0}) ::Ptr{Any}
-            return ccall((:jluna_invoke_lambda_0, cppcall._lib), Ptr{Any}, (Ptr{Cvoid},), f._native_handle);
+        @generated function (f::UnnamedFunction{Return_t, Args_t})(xs...) where {Return_t, Args_t}
+
+            n_args = fieldcount(Args_t)
+            if length(xs) != n_args
+                message = ": wrong number of arguments. expected " * string(n_args) * ", got " * string(length(xs)) * "."
+                return :(throw(ErrorException("MethodError: when trying to invoke <C++ Lambda#" * string(f._native_handle) * ">" * $message)))
+            end
+
+            arg_types = Expr(:tuple, :(Ptr{Cvoid}), (:Any for _ in 1:n_args)...)
+            args = [:(xs[$i]) for i in 1:n_args]
+            return :(ccall(f._invoke, Any, $arg_types, f._native_handle, $(args...))::$Return_t)
         end
 
-        # overload for 1 arg
-        function invoke_function(f::UnnamedFunction{1}, arg1::Ptr{Any}) ::Ptr{Any}
-            return ccall((:jluna_invoke_lambda_1, cppcall._lib), Ptr{Any}, (Ptr{Cvoid}, Ptr{Any}), f._native_handle, arg1);
+        """
+        object that is callable like a function, executes a C++-side function whose arguments and result are isbits.
+        Unlike UnnamedFunction, arguments are passed and the result is returned unboxed, using a single ccall
+        with the native types, such that calls are type-stable and may be inlined into the calling loop
+        """
+        mutable struct NativeFunction{Return_t, Args_t <: Tuple}
+
+            _native_handle::Ptr{Cvoid}
+            # points to C++-side function object
+
+            _invoke::Ptr{Cvoid}
+            # (Ptr{Cvoid}, Args_t...) -> Return_t
+
+            _free::Ptr{Cvoid}
+            # (Ptr{Cvoid}) -> Cvoid, deallocates the function object
+
+            function NativeFunction{Return_t, Args_t}(handle::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}) where {Return_t, Args_t <: Tuple}
+
+                out = new{Return_t, Args_t}(handle, invoke, free)
+                finalizer(function (t::NativeFunction)
+                    ccall(t._free, Cvoid, (Ptr{Cvoid},), t._native_handle)
+                end, out);
+
+                return out;
+            end
         end
 
-        # overload for 2 args
-        function invoke_function(f::UnnamedFunction{2}, arg1::Ptr{Any}, arg2::Ptr{Any}) ::Ptr{Any}
-            return ccall((:jluna_invoke_lambda_2, cppcall._lib), Ptr{Any}, (Ptr{Cvoid}, Ptr{Any}, Ptr{Any}), f._native_handle, arg1, arg2);
+        """
+        `make_native_function(::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Type, ::Type...) -> NativeFunction`
+
+        wrapper for NativeFunction ctor, `Nothing` as the return type designates a C++-side function returning void
+        """
+        function make_native_function(handle::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}, return_type::Type, arg_types::Type...)
+            return NativeFunction{return_type, Tuple{arg_types...}}(handle, invoke, free)
         end
 
-        # overload for 3 args
-        function invoke_function(f::UnnamedFunction{3}, arg1::Ptr{Any}, arg2::Ptr{Any}, arg3::Ptr{Any}) ::Ptr{Any}
-            return ccall((:jluna_invoke_lambda_3, cppcall._lib), Ptr{Any}, (Ptr{Cvoid}, Ptr{Any}, Ptr{Any}, Ptr{Any}), f._native_handle, arg1, arg2, arg3);
+        """
+        `NativeFunction(xs...) -> Return_t`
+
+        invoke NativeFunction, arguments are converted to the declared argument types by ccall
+        """
+        @generated function (f::NativeFunction{Return_t, Args_t})(xs...) where {Return_t, Args_t}
+
+            arg_types = fieldtypes(Args_t)
+            if length(xs) != length(arg_types)
+                message = "MethodError: when trying to invoke native <C++ Lambda>: wrong number of arguments. expected " *
+                    string(length(arg_types)) * ", got " * string(length(xs)) * "."
+                return :(throw(ErrorException($message)))
+            end
+
+            args = [:(xs[$i]) for i in 1:length(xs)]
+            return :(ccall(f._invoke, $Return_t, (Ptr{Cvoid}, $(arg_types...),), f._native_handle, $(args...)))
+        end
+
+        """
+        object that is callable like a function, executes a vectorized C++-side function.
+        Broadcasting or mapping it over a dense array with element type In_t results in a single ccall
+        handling the entire array, otherwise, it is invoked once per element
+        """
+        mutable struct BatchFunction{In_t, Out_t}
+
+            _native_handle::Ptr{Cvoid}
+            # points to C++-side function object
+
+            _invoke::Ptr{Cvoid}
+            # (Ptr{Cvoid}, Ptr{In_t}, Ptr{Out_t}, Csize_t) -> Cvoid
+
+            _free::Ptr{Cvoid}
+            # (Ptr{Cvoid}) -> Cvoid, deallocates the function object
+
+            function BatchFunction{In_t, Out_t}(handle::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}) where {In_t, Out_t}
+
+                out = new{In_t, Out_t}(handle, invoke, free)
+                finalizer(function (t::BatchFunction)
+                    ccall(t._free, Cvoid, (Ptr{Cvoid},), t._native_handle)
+                end, out);
+
+                return out;
+            end
         end
 
         """
-        `to_pointer(::Any) -> Ptr{Any}`
+        `make_batch_function(::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Type, ::Type) -> BatchFunction`
 
-        get pointer to any object (including immutable ones)
+        wrapper for BatchFunction ctor
         """
-        function to_pointer(x) ::Ptr{Any}
-            return ccall((:jluna_to_pointer, cppcall._lib), Ptr{Cvoid}, (Any,), x)
+        function make_batch_function(handle::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}, in_type::Type, out_type::Type)
+            return BatchFunction{in_type, out_type}(handle, invoke, free)
         end
 
         """
-        `from_pointer(::Ptr{Any}) -> Any`
+        `BatchFunction(x) -> Out_t`
 
-        wrap unsafe_pointer_to_objref
+        invoke BatchFunction for a single element
         """
-        function from_pointer(ptr::Ptr{Any})
-            return unsafe_pointer_to_objref(ptr)
+        function (f::BatchFunction{In_t, Out_t})(x) where {In_t, Out_t}
+
+            in = Ref{In_t}(x)
+            out = Ref{Out_t}()
+            ccall(f._invoke, Cvoid, (Ptr{Cvoid}, Ref{In_t}, Ref{Out_t}, Csize_t), f._native_handle, in, out, 1)
+            return out[]
         end
 
         """
-        `UnnamedFunction(xs...) -> Any`
+        `invoke_batch(::BatchFunction, ::DenseArray) -> Array`
 
-        invoke UnnamedFunction, checks for correct number of arguments
+        invoke BatchFunction once for all elements of a dense array
         """
-        function (f::UnnamedFunction{N})(xs...) where N
+        function invoke_batch(f::BatchFunction{In_t, Out_t}, xs::DenseArray{In_t}) where {In_t, Out_t}
 
-            n = length(xs)
+            out = similar(xs, Out_t)
+            GC.@preserve xs out begin
+                ccall(f._invoke, Cvoid, (Ptr{Cvoid}, Ptr{In_t}, Ptr{Out_t}, Csize_t), f._native_handle, pointer(xs), pointer(out), length(xs))
+            end
+            return out
+        end
 
-            if n == N == 0
-                return from_pointer(invoke_function(f));
-            elseif n == N == 1
-                return from_pointer(invoke_function(f, to_pointer(xs[1])));
-            elseif n == N == 2
-                return from_pointer(invoke_function(f, to_pointer(xs[1]), to_pointer(xs[2])));
-            elseif n == N == 3
-                return from_pt(invoke_function(f, to_pointer(xs[1]), to_pointer(xs[2]), to_pointer(xs[3])));
-            elseif N != 0 && N != 1 && N != 2 & N != 3
-                return from_pointer(invoke_function(f, to_pointer([xs...])));
-            else
-                throw(ErrorException(
-                    "MethodError: when trying to invoke <C++ Lambda#" * string(f._native_handle) * ">" *
-                    ": wrong number of arguments. expected " * string(N) * ", got " * string(n) * "."
-                   *  (n <= 3 ? "" : "\n\nTo create a C++-function that can take n > 3 arguments, simply make a 1-argument function with the only argument being an n-sized tuple or collection.")
-                ))
+        # `f.(xs)` and `map(f, xs)` for dense arrays, all other arguments use the elementwise fallback
+        Base.Broadcast.broadcasted(f::BatchFunction{In_t}, xs::DenseArray{In_t}) where In_t = invoke_batch(f, xs)
+        Base.map(f::BatchFunction{In_t}, xs::DenseArray{In_t}) where In_t = invoke_batch(f, xs)
+
+        # tasks cancelled through jluna::Task::cancel, checked only once any task was cancelled
+        const _cancelled_tasks = WeakKeyDict{Task, Nothing}()
+        const _any_task_cancelled = Threads.Atomic{Bool}(false)
+
+        """
+        `cancel_task(::Task) -> Bool`
+
+        mark task as cancelled, returns false if it is already done
+        """
+        function cancel_task(task::Task) ::Bool
+
+            if istaskdone(task)
+                return false
             end
+
+            _cancelled_tasks[task] = nothing
+            _any_task_cancelled[] = true
+            return true
+        end
+
+        """
+        `is_task_cancelled(::Task) -> Bool`
+        """
+        function is_task_cancelled(task::Task) ::Bool
+            return _any_task_cancelled[] && haskey(_cancelled_tasks, task)
         end
 
+        # threadpools are available since Julia 1.9
+        const _has_threadpools = isdefined(Base.Threads, :_spawn_set_thrpool)
 
         """
-        `make_task(::UInt64) -> Task`
+        `n_threads_in_pool(::Symbol) -> Int64`
+
+        number of threads in threadpool `:default` or `:interactive`
         """
-        function make_task(ptr::UInt64)
-            return Task() do;
+        function n_threads_in_pool(pool::Symbol) ::Int64
+
+            if _has_threadpools
+                return Threads.nthreads(pool)
+            else
+                return pool == :default ? Threads.nthreads() : 0
+            end
+        end
+
+        """
+        `make_task(::UInt64, ::Symbol) -> Task`
+
+        create task that may migrate between the threads of threadpool `pool`. If the task is cancelled before it started,
+        it fails without invoking the C++-side function
+        """
+        function make_task(ptr::UInt64, pool::Symbol = :default)
+
+            task = Task() do;
+                if is_task_cancelled(current_task())
+                    throw(InterruptException())
+                end
                 res_ptr = ccall((:jluna_invoke_from_task, _lib), Csize_t, (Csize_t,), ptr);
                 return unsafe_pointer_to_objref(Ptr{Any}(res_ptr))
             end
+
+            task.sticky = false
+            if _has_threadpools
+                # `_spawn_set_thrpool` is internal to Base, if it fails, use the default pool instead.
+                # It falls back to the default pool itself if `pool` has no threads
+                try
+                    Threads._spawn_set_thrpool(task, pool)
+                catch
+                    Threads._spawn_set_thrpool(task, :default)
+                end
+            end
+            return task
+        end
+
+        """
+        `spawn_batch(::UInt64, ::UInt64, ::Integer) -> Vector{Task}`
+
+        create and schedule `n` tasks, the i-th of which invokes the C++-side function at `base + (i - 1) * stride`
+        """
+        function spawn_batch(base::UInt64, stride::UInt64, n::Integer) ::Vector{Task}
+
+            tasks = Vector{Task}(undef, n)
+            for i in 1:n
+                ptr = base + UInt64(i - 1) * stride
+                task = Task() do;
+                    res_ptr = ccall((:jluna_invoke_from_task, _lib), Csize_t, (Csize_t,), ptr);
+                    return unsafe_pointer_to_objref(Ptr{Any}(res_ptr))
+                end
+                task.sticky = false
+                tasks[i] = task
+            end
+
+            for task in tasks
+                schedule(task)
+            end
+
+            return tasks
+        end
+
+        """
+        `spawn_detached(::UInt64) -> Nothing`
+
+        invoke C++-side function in a new task, which is not waited on. The function is deallocated C++-side once it returns
+        """
+        function spawn_detached(ptr::UInt64) ::Nothing
+
+            Threads.@spawn ccall((:jluna_invoke_detached, _lib), Cvoid, (Csize_t,), ptr)
+            return nothing
+        end
+
+        """
+        `resume_after(::Task, ::UInt64) -> Nothing`
+
+        schedule task if it was not yet started, then invoke C++-side function once it is done, without blocking the current thread.
+        The function is deallocated C++-side once it returns
+        """
+        function resume_after(task::Task, ptr::UInt64) ::Nothing
+
+            if !istaskstarted(task)
+                schedule(task)
+            end
+
+            Threads.@spawn begin
+                try
+                    wait(task)
+                catch
+                end
+                ccall((:jluna_invoke_detached, _lib), Cvoid, (Csize_t,), ptr)
+            end
+            return nothing
+        end
+
+        """
+        `executor_worker(::UInt64, ::Base.AsyncCondition) -> Nothing`
+
+        execute items of a C++-side jluna::Executor until it is stopped. While its queue is empty,
+        the worker waits C++-side for a short time, then waits on `cond`, which is signalled by the next submit
+        """
+        function executor_worker(ptr::UInt64, cond::Base.AsyncCondition) ::Nothing
+
+            while true
+                status = ccall((:jluna_executor_drain, _lib), Cint, (Csize_t,), ptr)
+                if status == 2
+                    return nothing
+                elseif status == 0
+                    wait(cond)
+                end
+            end
+        end
+
+        """
+        `make_executor(::UInt64, ::Integer) -> Tuple{Vector{Task}, Base.AsyncCondition}`
+        """
+        function make_executor(ptr::UInt64, n_workers::Integer) ::Tuple{Vector{Task}, Base.AsyncCondition}
+
+            cond = Base.AsyncCondition()
+            return (Task[Threads.@spawn executor_worker(ptr, cond) for _ in 1:n_workers], cond)
+        end
+
+        """
+        `get_executor_async_handle(::Tuple{Vector{Task}, Base.AsyncCondition}) -> Ptr{Cvoid}`
+        """
+        function get_executor_async_handle(workers::Tuple{Vector{Task}, Base.AsyncCondition}) ::Ptr{Cvoid}
+            return workers[2].handle
+        end
+
+        """
+        `stop_executor(::Tuple{Vector{Task}, Base.AsyncCondition}) -> Nothing`
+
+        wait for all workers to exit, then release the condition
+        """
+        function stop_executor(workers::Tuple{Vector{Task}, Base.AsyncCondition}) ::Nothing
+
+            wait_all(workers[1], false)
+            close(workers[2])
+            return nothing
+        end
+
+        """
+        `wait_all(::Vector{Task}, ::Bool) -> Nothing`
+
+        wait for all tasks to finish, if `propagate` is false, failed tasks are ignored
+        """
+        function wait_all(tasks::Vector{Task}, propagate::Bool) ::Nothing
+
+            for task in tasks
+                if propagate
+                    wait(task)
+                else
+                    try
+                        wait(task)
+                    catch
+                    end
+                end
+            end
+
+            return nothing
+        end
+
+        """
+        `run_workers(::UInt64, ::Integer) -> Nothing`
+
+        invoke the same C++-side function `n` times, each in its own task, then wait for all of them to finish
+        """
+        function run_workers(ptr::UInt64, n::Integer) ::Nothing
+
+            tasks = Vector{Task}(undef, n)
+            for i in 1:n
+                tasks[i] = Threads.@spawn ccall((:jluna_invoke_from_task, _lib), Csize_t, (Csize_t,), ptr)
+            end
+
+            for task in tasks
+                wait(task)
+            end
+
+            return nothing
         end
     end
 
@@ -0,0 +1,110 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/array.hpp>
+#include <include/multi_threading.hpp>
+#include <.src/kernel_table.hpp>
+
+namespace jluna::kernels
+{
+    /// @brief instruction set used by all kernels
+    enum class InstructionSet
+    {
+        SCALAR,
+        AVX2,
+        AVX512
+    };
+
+    /// @brief is the instruction set supported by both the CPU and this build of jluna
+    /// @param instruction_set
+    /// @returns true if supported, always true for InstructionSet::SCALAR
+    bool is_supported(InstructionSet);
+
+    /// @brief get the instruction set currently used, on startup this is the widest supported instruction set
+    /// @returns instruction set
+    InstructionSet get_instruction_set();
+
+    /// @brief override the instruction set used by all kernels, mainly useful for testing and benchmarking
+    /// @param instruction_set: has to be supported
+    /// @throws std::invalid_argument if the instruction set is not supported
+    void set_instruction_set(InstructionSet);
+
+    /// @concept: value type that kernels are available for
+    template<typename T>
+    concept is_kernel_value = is<T, float> or is<T, double>;
+
+    /// @brief sum of all elements
+    /// @param array: dense array
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @returns sum, 0 if array is empty
+    template<is_kernel_value T, size_t R>
+    T sum(const Array<T, R>& array, bool use_threadpool = false);
+
+    /// @brief smallest element
+    /// @param array: dense array, may not be empty
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @returns smallest element, unspecified if the array contains NaN
+    /// @throws std::invalid_argument if array is empty
+    template<is_kernel_value T, size_t R>
+    T minimum(const Array<T, R>& array, bool use_threadpool = false);
+
+    /// @brief largest element
+    /// @param array: dense array, may not be empty
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @returns largest element, unspecified if the array contains NaN
+    /// @throws std::invalid_argument if array is empty
+    template<is_kernel_value T, size_t R>
+    T maximum(const Array<T, R>& array, bool use_threadpool = false);
+
+    /// @brief dot product, elements are visited in column-major order
+    /// @param a: dense array
+    /// @param b: dense array, same number of elements as a
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @returns sum of a[i] * b[i] for all i
+    /// @throws std::invalid_argument if the number of elements does not match
+    template<is_kernel_value T, size_t R>
+    T dot(const Array<T, R>& a, const Array<T, R>& b, bool use_threadpool = false);
+
+    /// @brief y = alpha * x + y, in-place
+    /// @param alpha: scalar
+    /// @param x: dense array
+    /// @param y: dense array, same number of elements as x, modified
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @throws std::invalid_argument if the number of elements does not match
+    template<is_kernel_value T, size_t R>
+    void axpy(T alpha, const Array<T, R>& x, Array<T, R>& y, bool use_threadpool = false);
+
+    /// @brief euclidean norm of all elements
+    /// @param array: dense array
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @returns sqrt of the sum of squares, elements are not rescaled so very large values may overflow
+    template<is_kernel_value T, size_t R>
+    T norm(const Array<T, R>& array, bool use_threadpool = false);
+
+    /// @brief count elements into n_bins equally sized bins over [min, max)
+    /// @param array: dense array
+    /// @param n_bins: number of bins, has to be in [1, 2^31 - 1]
+    /// @param min: lower bound of the first bin, inclusive
+    /// @param max: upper bound of the last bin, exclusive
+    /// @param use_threadpool: should the work be distributed across all Julia threads
+    /// @returns vector of size n_bins, elements outside of [min, max) and NaN are not counted
+    /// @throws std::invalid_argument if n_bins is out of range or min >= max
+    template<is_kernel_value T, size_t R>
+    std::vector<size_t> histogram(const Array<T, R>& array, size_t n_bins, T min, T max, bool use_threadpool = false);
+
+    namespace detail
+    {
+        // kernels of the currently selected instruction set
+        template<typename T>
+        const KernelTable<T>& get_kernel_table();
+
+        template<> const KernelTable<float>& get_kernel_table<float>();
+        template<> const KernelTable<double>& get_kernel_table<double>();
+    }
+}
+
+#include <.src/kernels.inl>
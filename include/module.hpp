@@ -11,8 +11,103 @@
 #include <include/symbol.hpp>
 #include <include/mutex.hpp>
 
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+
 namespace jluna
 {
+    /// @brief set of assignments that are applied to a module at once, see Module::assign_many and Module::create_or_assign_many
+    class AssignmentBatch
+    {
+        friend class Module;
+
+        public:
+            /// @brief single assignment, values are boxed only once the batch is applied
+            struct Entry
+            {
+                /// @brief ctor
+                /// @param variable_name: variable name, should not contain "."
+                /// @param value: new value
+                template<is_boxable T>
+                Entry(const std::string& variable_name, T value);
+
+                unsafe::Symbol* _name;
+                std::function<unsafe::Value*()> _box;
+            };
+
+            /// @brief ctor, empty batch
+            AssignmentBatch() = default;
+
+            /// @brief ctor from entries
+            /// @param entries: list of {variable_name, value}
+            AssignmentBatch(std::initializer_list<Entry>);
+
+            /// @brief add assignment, does not call into Julia
+            /// @param variable_name: variable name, should not contain "."
+            /// @param value: new value
+            /// @returns reference to self
+            template<is_boxable T>
+            AssignmentBatch& add(const std::string& variable_name, T value);
+
+            /// @brief get number of assignments
+            /// @returns number
+            size_t size() const;
+
+            /// @brief remove all assignments
+            void clear();
+
+        private:
+            std::vector<Entry> _entries;
+    };
+
+    // jl_binding_t is only read directly for Julia versions before 1.12, which partitions bindings by world age. Newer or unknown versions look up the value through jl_get_global
+    #if defined(JULIA_VERSION_MAJOR) and JULIA_VERSION_MAJOR == 1 and JULIA_VERSION_MINOR < 12
+        #define JLUNA_DIRECT_BINDING_ACCESS
+    #endif
+
+    /// @brief handle to a global variable of a module, which caches the variables binding, such that reading its value does not need to look up the variable.
+    /// Reassigning the variable Julia-side is reflected by the handle. Only create using Module::binding
+    template<is_unboxable T>
+    class Binding
+    {
+        friend class Module;
+
+        public:
+            /// @brief get current value of the variable
+            /// @returns value, unboxed
+            /// @throws UndefVarError if the variable is no longer defined
+            T get() const;
+
+            /// @brief get current value of the variable, equivalent to get
+            /// @returns value, unboxed
+            operator T() const;
+
+            /// @brief get name of the variable
+            /// @returns name
+            std::string get_name() const;
+
+            /// @brief was the variable declared const
+            /// @returns bool
+            bool is_const() const;
+
+        private:
+            Binding(unsafe::Module*, unsafe::Symbol*);
+
+            unsafe::Module* _module;
+            unsafe::Symbol* _name;
+            bool _is_const;
+
+            // nullptr unless JLUNA_DIRECT_BINDING_ACCESS is defined
+            jl_binding_t* _binding = nullptr;
+
+            // Julia-side type equivalent of T, only used if T is a native type
+            unsafe::Value* _type = nullptr;
+
+            // variable is declared with exactly _type, such that its value does not have to be type-checked
+            bool _type_checked = false;
+    };
+
     // wraps jl_module_t*
     class Module : public Proxy
     {
@@ -58,6 +153,26 @@ namespace jluna
             template<is_boxable T>
             void create_or_assign(const std::string& variable_name, T value);
 
+            /// @brief [thread-safe] assign multiple variables in module, taking the lock once. All values are boxed and checked before any of them is assigned,
+            /// if any variable does not exist, is a constant or does not match the type of a typed global, throw and leave the module unchanged
+            /// @param batch: assignments, applied in order
+            void assign_many(const AssignmentBatch& batch);
+
+            /// @brief [thread-safe] assign multiple variables in module, taking the lock once. All values are boxed and checked before any of them is assigned,
+            /// if any variable does not exist, is a constant or does not match the type of a typed global, throw and leave the module unchanged
+            /// @param entries: list of {variable_name, value}, applied in order
+            void assign_many(std::initializer_list<AssignmentBatch::Entry> entries);
+
+            /// @brief [thread-safe] assign multiple variables in module, taking the lock once. Variables that do not exist are created.
+            /// If any variable is a constant or does not match the type of a typed global, throw and leave the module unchanged
+            /// @param batch: assignments, applied in order
+            void create_or_assign_many(const AssignmentBatch& batch);
+
+            /// @brief [thread-safe] assign multiple variables in module, taking the lock once. Variables that do not exist are created.
+            /// If any variable is a constant or does not match the type of a typed global, throw and leave the module unchanged
+            /// @param entries: list of {variable_name, value}, applied in order
+            void create_or_assign_many(std::initializer_list<AssignmentBatch::Entry> entries);
+
             /// @brief get variable value as named proxy
             /// @param variable_name: name of variable
             /// @returns proxy
@@ -70,6 +185,14 @@ namespace jluna
             template<is_unboxable T>
             T get(const std::string& variable_name);
 
+            /// @brief get handle to variable, which reads its value without looking up the variable each time
+            /// @tparam T: type the value is unboxed to
+            /// @param variable_name: name of variable
+            /// @returns handle, valid as long as the module exists
+            /// @throws UndefVarError if the variable is not defined
+            template<is_unboxable T>
+            Binding<T> binding(const std::string& variable_name);
+
             /// @brief [thread-safe] creates new variable in main, then returns named proxy to it
             /// @param variable_name: exact name of variable
             /// @returns named proxy to newly created value
@@ -266,6 +389,11 @@ namespace jluna
 
             void initialize_lock();
             Mutex* _lock;
+
+            // lock the module. Locks even if Julia is single-threaded, because threads adopted through ThreadGuard may access it concurrently
+            std::unique_lock<Mutex> acquire_lock();
+
+            void apply(const std::vector<AssignmentBatch::Entry>&, bool create);
     };
 
     /// @brief Proxy of singleton Main, initialized by State::initialize
@@ -11,7 +11,13 @@
 #include <include/box.hpp>
 
 #include <thread>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <optional>
+#include <tuple>
+#include <vector>
 #include <condition_variable>
 
 
@@ -30,6 +36,10 @@
  * for safe access into both the Julia and
  * C++ state from within a thread.
  *
+ * The only exception is a thread that holds a
+ * jluna::ThreadGuard (Julia 1.9 or newer), see
+ * include/thread_guard.hpp.
+ *
  * Julia-side threads/tasks issued through
  * the `Threads` library (via @spawn, @threads,
  * @async, etc.) are also safe.
@@ -43,22 +53,119 @@
 
 namespace jluna
 {
+    /// @brief Julia-side threadpool a task is scheduled on, c.f. `Threads.@spawn :interactive`
+    enum class ThreadPoolKind : uint8_t
+    {
+        /// @brief default pool, for throughput-oriented work
+        DEFAULT = 0,
+
+        /// @brief interactive pool, for latency-critical work. Requires Julia 1.9 or newer, if the pool has no threads, tasks are scheduled on the default pool instead
+        INTERACTIVE = 1
+    };
+
+    /// @brief statistics of a Julia-side threadpool, see ThreadPool::get_stats
+    struct ThreadPoolStats
+    {
+        /// @brief number of threads in the pool
+        size_t n_threads;
+
+        /// @brief number of tasks that were scheduled through jluna::Task::schedule, but did not yet start
+        size_t n_queued;
+
+        /// @brief number of tasks currently executing their C++-side function
+        size_t n_running;
+    };
+
     namespace detail
     {
         // forward declarations
         class FutureHandler;
         struct TaskSuper {
             virtual void free() {};
+            virtual ~TaskSuper() = default;
+
+            // 0: created, 1: queued, 2: running, 3: done
+            std::atomic<uint8_t> _stage = 0;
+            ThreadPoolKind _pool = ThreadPoolKind::DEFAULT;
         };
         template<typename>struct TaskValue;
+        template<typename>struct TaskGroupValue;
+        template<typename>struct FutureState;
+
+        // value type of the future returned by Future::then, void results are represented as jl_nothing
+        template<typename T>
+        using as_future_value_t = std::conditional_t<std::is_void_v<T>, unsafe::Value*, T>;
+
+        // type-erased callable with signature () -> unsafe::Value*, stores small callables inline instead of on the heap
+        class TaskCallable
+        {
+            public:
+                TaskCallable() = default;
+                ~TaskCallable();
+
+                TaskCallable(const TaskCallable&) = delete;
+                TaskCallable& operator=(const TaskCallable&) = delete;
+
+                template<typename Lambda_t>
+                void emplace(Lambda_t&& lambda);
+
+                void reset();
+
+                unsafe::Value* operator()();
+
+            private:
+                // fits the closure of ThreadPool::create for up to a few arguments
+                static constexpr size_t _buffer_size = 128;
+                alignas(std::max_align_t) std::byte _buffer[_buffer_size];
+
+                void* _target = nullptr;
+                unsafe::Value* (*_invoke)(void*) = nullptr;
+                void (*_destroy)(void*) = nullptr;
+        };
+
+        // slot of the threadpool task registry
+        struct TaskSlot
+        {
+            TaskSuper* task = nullptr;
+            TaskCallable callable;
+            std::atomic<uint32_t> next_free = 0;
+        };
+
+        // lock-free table of task slots. Slots are allocated in slabs, which are never moved or deallocated,
+        // such that pointers to a slot stay valid. Freed slots are kept in a lock-free stack and reused
+        class TaskSlotTable
+        {
+            public:
+                // get a free slot, allocates a new slab only if no freed slot is available
+                size_t allocate();
+
+                // return slot to the table, its task and callable have to be reset beforehand
+                void free(size_t id);
+
+                // access slot
+                TaskSlot& at(size_t id);
+
+            private:
+                static constexpr size_t _slab_size = 256;
+                static constexpr size_t _max_n_slabs = 4096;
+
+                // lower 32 bits: 1-based index of first free slot (0 if empty), upper 32 bits: tag that prevents ABA
+                std::atomic<uint64_t> _free_head = 0;
+                std::atomic<size_t> _n_used = 0;
+                std::array<std::atomic<TaskSlot*>, _max_n_slabs> _slabs = {};
+        };
     }
 
-    /// @brief the result of a thread
+    /// @brief the result of a thread. Copies of a future share the same state
     template<typename Value_t>
     class Future
     {
         template<typename>
         friend class TaskValue;
+
+        template<typename>
+        friend class Future;
+
         friend class detail::FutureHandler;
 
         public:
@@ -73,19 +180,57 @@ namespace jluna
             /// @returns true if task .is_done() returns true, false otherwise
             bool is_available();
 
-            /// @brief pause the current thread until the futures value becomes available
+            /// @brief check if the value will never become available, thread-safe
+            /// @returns true if the function computing the value threw an exception or its task was cancelled, false otherwise
+            bool is_failed();
+
+            /// @brief pause the current thread until the futures value becomes available or the future failed
             /// @returns value, if task failed, optional will not contain a value
             std::optional<Value_t> wait();
 
+            /// @brief register a continuation, which is invoked in a new Julia-side task once the value becomes available
+            /// @param f: function with signature (const Value_t&) -> T
+            /// @returns future holding the result of f, jl_nothing if T is void. If f throws or this future fails, the returned future fails
+            /// @throws std::runtime_error if the current thread is not a Julia thread. C++-side threads, such as clients of a jluna::Executor, have to hold a jluna::ThreadGuard
+            /// @note if the value is already available, the continuation is scheduled immediately, from the calling thread
+            template<typename Function_t,
+                typename T = std::invoke_result_t<Function_t, const Value_t&>
+            >
+            Future<detail::as_future_value_t<T>> then(Function_t f);
+
         private:
-            void set_value(Value_t);
+            void set_value(Value_t&&);
+            void set_failed();
 
-            std::mutex _mutex;
-            std::condition_variable _cv;
-            std::unique_lock<std::mutex> _cv_lock;
-            std::unique_ptr<Value_t> _value;
+            std::shared_ptr<detail::FutureState<Value_t>> _state;
     };
 
+    /// @brief create a future that becomes available once all futures are available
+    /// @param futures: futures, may have different value types
+    /// @returns future holding a tuple of all values, fails if any of the futures fails
+    template<typename... Ts>
+    Future<std::tuple<Ts...>> when_all(Future<Ts>... futures);
+
+    /// @brief create a future that becomes available once all futures are available
+    /// @param futures: vector of futures
+    /// @returns future holding all values, in the same order as futures. Fails if any of the futures fails
+    template<typename T>
+    Future<std::vector<T>> when_all(const std::vector<Future<T>>& futures);
+
+    /// @brief create a future that becomes available once any of the futures is available
+    /// @param futures: vector of futures, may not be empty
+    /// @returns future holding the index and value of the first future to become available. Fails if all of the futures fail
+    /// @throws std::invalid_argument if futures is empty
+    template<typename T>
+    Future<std::pair<size_t, T>> when_any(const std::vector<Future<T>>& futures);
+
+    /// @brief create a future that becomes available once any of the futures is available
+    /// @param first: future
+    /// @param rest: futures with the same value type as first
+    /// @returns future holding the index and value of the first future to become available. Fails if all of the futures fail
+    template<typename T, typename... Ts> requires (std::is_same_v<T, Ts> and ...)
+    Future<std::pair<size_t, T>> when_any(Future<T> first, Future<Ts>... rest);
+
     template<typename Result_t>
     class Task
     {
@@ -118,6 +263,12 @@ namespace jluna
             /// @brief start the thread
             void schedule();
 
+            /// @brief request cancellation. If the task was not yet started, the C++-side function is never invoked. If it is running,
+            /// jluna::is_cancelled returns true and Julia-side `jluna.check_cancelled()` throws an InterruptException within it, the function itself decides when to return. In both cases, the future fails immediately
+            /// @note cancellation is cooperative: it is not delivered at a safepoint or otherwise interrupts the task, a function that never checks runs to completion
+            /// @returns false if the task was already done, true otherwise
+            bool cancel();
+
             /// @brief is task finished
             /// @returns true if .result() is available, false otherwise
             bool is_done() const;
@@ -142,6 +293,63 @@ namespace jluna
             detail::TaskValue<Result_t>* _value; // lifetime managed by threadpool
     };
 
+    /// @brief group of tasks created and scheduled with a single Julia-side call, see ThreadPool::spawn_batch
+    /// @note the whole group is protected from the garbage collector using a single handle
+    template<typename Result_t>
+    class TaskGroup
+    {
+        friend class ThreadPool;
+
+        public:
+            /// @brief type of the futures values, jluna::unsafe::Value* if Result_t is void
+            using Value_t = std::conditional_t<std::is_void_v<Result_t>, unsafe::Value*, Result_t>;
+
+            /// @brief dtor, blocks until all tasks of the group are done
+            ~TaskGroup();
+
+            /// @brief copy assignment deleted
+            TaskGroup& operator=(const TaskGroup&) = delete;
+
+            /// @brief copy ctor deleted
+            TaskGroup(const TaskGroup&) = delete;
+
+            /// @brief move ctor
+            /// @param other: other group, will be unusable after
+            TaskGroup(TaskGroup&& other);
+
+            /// @brief move assignment
+            /// @param other: other group, will be unusable after
+            TaskGroup& operator=(TaskGroup&& other);
+
+            /// @brief access the Julia-side value of type Vector{Task}, implicit
+            operator unsafe::Value*();
+
+            /// @brief stall the thread this function is called from until all tasks are done, using a single Julia-side call
+            /// @throws JuliaException if any of the tasks failed
+            void wait_all();
+
+            /// @brief are all tasks finished
+            /// @returns true if all results are available, false otherwise
+            bool is_done() const;
+
+            /// @brief get number of tasks
+            /// @returns number
+            size_t size() const;
+
+            /// @brief access the result of the i-th task
+            /// @param i: index, 0-based, in the same order as the callables handed to ThreadPool::spawn_batch
+            /// @returns future
+            /// @throws std::out_of_range if i >= size()
+            Future<Value_t>& result(size_t i);
+
+        protected:
+            /// @brief ctor private, use ThreadPool::spawn_batch
+            TaskGroup(std::unique_ptr<detail::TaskGroupValue<Result_t>>);
+
+        private:
+            std::unique_ptr<detail::TaskGroupValue<Result_t>> _value;
+    };
+
     /// @brief threadpool that allows scheduled C++-side tasks to safely access the Julia State from within a thread.
     /// Pool cannot be resized, it will use the native Julia threads to execute any C++-side tasks
     /// @note during task creation, the copy ctor will be invoked for all arguments `args` and the functions return value. To avoid this, wrap the type in an std::ref
@@ -177,10 +385,56 @@ namespace jluna
             >
             [[nodiscard]] static Task<T> create(Lambda_t f, Args_t... args);
 
+            /// @brief create a task from a std::function returning void, to be scheduled on a specific threadpool
+            /// @param pool: Julia-side threadpool
+            /// @param f: function returning void
+            /// @param args: arguments
+            /// @returns Task, not yet scheduled
+            template<typename... Args_t>
+            [[nodiscard]] static Task<void> create(ThreadPoolKind pool, const std::function<void(Args_t...)>& f, Args_t... args);
+
+            /// @brief create a task from a std::function returning non-void, to be scheduled on a specific threadpool
+            /// @param pool: Julia-side threadpool
+            /// @param f: function
+            /// @param args: arguments
+            /// @returns Task, not yet scheduled
+            template<is_not<void> Return_t, typename... Args_t>
+            [[nodiscard]] static Task<Return_t> create(ThreadPoolKind pool, const std::function<Return_t(Args_t...)>& f, Args_t... args);
+
+            /// @brief create a task from a lambda, to be scheduled on a specific threadpool
+            /// @param pool: Julia-side threadpool
+            /// @param f: lambda
+            /// @param args: arguments
+            /// @returns Task, not yet scheduled
+            template<typename Signature,
+                typename Lambda_t,
+                typename... Args_t,
+                typename T = std::invoke_result_t<std::function<Signature>, Args_t...>
+            >
+            [[nodiscard]] static Task<T> create(ThreadPoolKind pool, Lambda_t f, Args_t... args);
+
+            /// @brief create and schedule one task per callable. All tasks are created, configured and scheduled using a single Julia-side call
+            /// @param callables: range of callables with signature () -> T, each is copied into the group
+            /// @returns TaskGroup, already scheduled
+            template<Iterable Range_t,
+                typename T = std::invoke_result_t<typename Range_t::value_type>
+            >
+            [[nodiscard]] static TaskGroup<T> spawn_batch(const Range_t& callables);
+
             /// @brief get number of threads
             /// @returns number
             static size_t n_threads();
 
+            /// @brief get number of threads of a specific threadpool
+            /// @param pool: Julia-side threadpool
+            /// @returns number, 0 if the pool does not exist
+            static size_t n_threads(ThreadPoolKind pool);
+
+            /// @brief get statistics of a threadpool. Only tasks created through ThreadPool::create are counted, under the pool they run in: if the interactive pool has no threads, tasks created for it count towards the default pool
+            /// @param pool: Julia-side threadpool
+            /// @returns statistics
+            static ThreadPoolStats get_stats(ThreadPoolKind pool = ThreadPoolKind::DEFAULT);
+
             /// @brief get id of current task
             /// @returns number
             static size_t thread_id();
@@ -188,17 +442,40 @@ namespace jluna
         private:
             static void free(size_t id);
 
-            static inline size_t _current_id = 0;
-            static inline std::mutex _storage_lock = std::mutex();
-            static inline std::map<size_t,
-                std::pair<
-                    detail::TaskSuper*,
-                    std::unique_ptr<std::function<unsafe::Value*()>>
-                >> _storage = {};
+            static inline detail::TaskSlotTable _slots = {};
     };
 
     /// @brief pause the current task, has to be called from within a task allocated via ThreadPool::create
     void yield();
+
+    /// @brief half-open range of indices [first, last), used by parallel_for and parallel_reduce
+    struct IndexRange
+    {
+        /// @brief first index, inclusive
+        size_t first;
+
+        /// @brief last index, exclusive
+        size_t last;
+    };
+
+    /// @brief execute a function for all indices in a range, distributed across all Julia threads. Blocks until all indices were processed
+    /// @param range: half-open range of indices [first, last)
+    /// @param grain: number of indices a thread claims at once, if 0, the grain is chosen automatically
+    /// @param f: function with signature (size_t i) -> void, invoked once per index, or (size_t first, size_t last) -> void, invoked once per claimed chunk [first, last)
+    /// @note exactly min(ThreadPool::n_threads(), number of chunks) Julia-side tasks are scheduled, chunks are claimed dynamically by incrementing a shared atomic cursor
+    /// @note if f throws, no further chunks are claimed and the first exception is rethrown from the calling thread
+    template<typename Function_t>
+    void parallel_for(IndexRange range, size_t grain, Function_t f);
+
+    /// @brief reduce all indices in a range, distributed across all Julia threads. Blocks until all indices were processed
+    /// @param range: half-open range of indices [first, last)
+    /// @param identity: identity element of combine, each thread starts with a copy of it as its local accumulator
+    /// @param f: function with signature (Result_t accumulator, size_t i) -> Result_t
+    /// @param combine: function with signature (Result_t, Result_t) -> Result_t, used to merge the local accumulators. Has to be associative and commutative, as chunks are claimed in no particular order
+    /// @param grain: number of indices a thread claims at once, if 0, the grain is chosen automatically
+    /// @returns result of the reduction, identity if the range is empty
+    template<typename Result_t, typename Function_t, typename Combine_t>
+    Result_t parallel_reduce(IndexRange range, Result_t identity, Function_t f, Combine_t combine, size_t grain = 0);
 }
 
 #include <.src/multi_threading.inl>
\ No newline at end of file
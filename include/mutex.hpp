@@ -7,9 +7,15 @@
 
 #include <include/concepts.hpp>
 
+#include <atomic>
+#include <chrono>
+
 namespace jluna
 {
-    /// @brief thread-safe wrapper for Base.ReentrantLock, lockable and capable of stalling both a Julia task and a C++ thread
+    /// @brief lock that can be locked and unlocked from both C++ and Julia, boxes to the Julia-side jluna.Mutex.
+    /// Its state is a single atomic word shared between C++ and Julia, such that an uncontended lock or unlock is a single atomic operation on both sides.
+    /// Under contention, the lock spins briefly, then parks: C++-side threads wait on the word, Julia threads yield to the Julia scheduler
+    /// @note unlike Base.ReentrantLock, the lock is not reentrant
     class Mutex
     {
         template<is<Mutex> T>
@@ -19,6 +25,15 @@ namespace jluna
             /// @brief construct
             Mutex();
 
+            /// @brief copy ctor, the copy refers to the same lock
+            /// @param other
+            Mutex(const Mutex&);
+
+            /// @brief copy assignment, afterwards both refer to the same lock
+            /// @param other
+            /// @returns reference to self
+            Mutex& operator=(const Mutex&);
+
             /// @brief destruct
             ~Mutex();
 
@@ -29,13 +44,19 @@ namespace jluna
             void unlock();
 
             /// @brief lock if possible, otherwise return and continue
-            void try_lock();
+            /// @returns true if the lock was acquired, false otherwise
+            bool try_lock();
+
+            /// @brief try to lock until timeout is reached
+            /// @param timeout: maximum duration to wait for
+            /// @returns true if the lock was acquired, false otherwise
+            bool try_lock_for(std::chrono::nanoseconds timeout);
 
             /// @brief is locked
             /// @returns bool
             bool is_locked() const;
 
-            /// @brief get julia-side Base.ReentrantLock
+            /// @brief get julia-side jluna.Mutex
             /// @returns value
             operator unsafe::Value*();
 
@@ -44,6 +65,60 @@ namespace jluna
 
             unsafe::Value* _value;
             size_t _value_id;
+
+            // 0: unlocked, 1: locked, 2: locked and there may be threads waiting
+            uint32_t* _state;
+    };
+
+    /// @brief C++-side reader-writer lock, allowing either multiple readers or a single writer. Spins briefly, then parks, in the same way as jluna::Mutex
+    /// @note usable with std::unique_lock and std::shared_lock
+    class RWMutex
+    {
+        public:
+            /// @brief construct
+            RWMutex() = default;
+
+            /// @brief copy ctor deleted
+            RWMutex(const RWMutex&) = delete;
+
+            /// @brief copy assignment deleted
+            RWMutex& operator=(const RWMutex&) = delete;
+
+            /// @brief stall until exclusive locking is possible
+            void lock();
+
+            /// @brief free exclusive lock
+            void unlock();
+
+            /// @brief lock exclusively if possible, otherwise return and continue
+            /// @returns true if the lock was acquired, false otherwise
+            bool try_lock();
+
+            /// @brief try to lock exclusively until timeout is reached
+            /// @param timeout: maximum duration to wait for
+            /// @returns true if the lock was acquired, false otherwise
+            bool try_lock_for(std::chrono::nanoseconds timeout);
+
+            /// @brief stall until shared locking is possible
+            void lock_shared();
+
+            /// @brief free shared lock
+            void unlock_shared();
+
+            /// @brief lock shared if possible, otherwise return and continue
+            /// @returns true if the lock was acquired, false otherwise
+            bool try_lock_shared();
+
+            /// @brief try to lock shared until timeout is reached
+            /// @param timeout: maximum duration to wait for
+            /// @returns true if the lock was acquired, false otherwise
+            bool try_lock_shared_for(std::chrono::nanoseconds timeout);
+
+        private:
+            static constexpr uint32_t _writer = uint32_t(1) << 31;
+
+            // highest bit: locked exclusively, other bits: number of readers
+            std::atomic<uint32_t> _state = 0;
     };
 }
 
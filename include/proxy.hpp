@@ -165,6 +165,12 @@ namespace jluna
             void update();
 
         protected:
+            /// @brief construct with no owner from a value that is never garbage collected, such as a type declared in Core. Does not register the value with the memory handler until the proxy is mutated
+            /// @param value: value, has to stay reachable for the lifetime of the Julia state
+            /// @param symbol: name
+            /// @param is_permanent: if false, equivalent to Proxy(value, symbol)
+            Proxy(unsafe::Value* value, jl_sym_t* symbol, bool is_permanent);
+
             std::shared_ptr<ProxyValue> _content;
     };
 
@@ -189,7 +195,8 @@ namespace jluna
             /// @brief ctor without owner
             /// @param value: pointer to value
             /// @param id: jluna.memory_handler.ProxyID object
-            ProxyValue(unsafe::Value* value, jl_sym_t* id);
+            /// @param is_permanent: if true, value and id are stored directly instead of being registered with the memory handler
+            ProxyValue(unsafe::Value* value, jl_sym_t* id, bool is_permanent = false);
 
             /// @brief ctor with owner and proper name
             /// @param value: pointer to value
@@ -205,12 +212,18 @@ namespace jluna
             /// @returns pointer to field data
             unsafe::Value* get_field(jl_sym_t*);
 
+            /// @brief register value and id of a permanent proxy value with the memory handler, such that it can be mutated. No-op otherwise
+            void make_referenced();
+
             /// @brief owner
             std::shared_ptr<ProxyValue> _owner;
 
             /// @brief points to julia-side variable
             const bool _is_mutating = true;
 
+            /// @brief _id_ref and _value_ref are the id and value themself, the keys are unused
+            bool _is_permanent = false;
+
             size_t _id_key;
             size_t _value_key;
 
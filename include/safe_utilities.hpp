@@ -18,12 +18,16 @@ namespace jluna
     /// @param n_threads: number of threads to initialize the julia threadpool with. Default: 1
     /// @param suppress_log: should logging be disabled. Default: No
     /// @param jluna_shared_library_path: absolute path that is the location of libjluna.so. Leave empty to use default path
-    /// @param jluna_image_path: absolute path that is the location of the julia image. Leave empty to use default path
+    /// @param julia_image_path: path to a sysimage file, for example one built by the jluna_sysimage target, or to the directory containing the julia binary. Leave empty to use default path
+    /// @param n_interactive_threads: number of threads of the interactive threadpool, see ThreadPoolKind::INTERACTIVE. Ignored for Julia versions older than 1.9. Default: 0
+    /// @param profile_startup: should wall time, compile time and allocations of each phase of initialization be recorded, see jluna::startup_report. Default: No
     void initialize(
         size_t n_threads = 1,
         bool suppress_log = false,
         const std::string& jluna_shared_library_path = "",
-        const std::string& julia_image_path = ""
+        const std::string& julia_image_path = "",
+        size_t n_interactive_threads = 0,
+        bool profile_startup = false
     );
 
     /// @brief call function with args, with verbose exception forwarding
@@ -31,6 +35,7 @@ namespace jluna
     /// @param function: function
     /// @param args: arguments, either need to be already Julia-side or boxable
     /// @returns result
+    /// @throws JuliaException if the function throws, CancellationException if it was cancelled
     template<is_julia_value_pointer... Args_t>
     unsafe::Value* safe_call(unsafe::Function* function, Args_t... args);
 
@@ -0,0 +1,88 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/julia_wrapper.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace jluna
+{
+    /// @brief measurements of a single phase of jluna::initialize
+    struct StartupPhase
+    {
+        /// @brief name of the phase
+        std::string name;
+
+        /// @brief wall time
+        std::chrono::nanoseconds wall_time;
+
+        /// @brief time spent compiling Julia code, always 0 for Julia versions older than 1.8
+        std::chrono::nanoseconds compile_time;
+
+        /// @brief number of bytes allocated by the Julia GC
+        uint64_t n_bytes_allocated;
+    };
+
+    /// @brief measurements of jluna::initialize, recorded if initialize was called with profile_startup = true
+    struct StartupReport
+    {
+        /// @brief phases, in the order they were executed
+        std::vector<StartupPhase> phases;
+
+        /// @brief get sum of the wall time of all phases
+        /// @returns duration
+        std::chrono::nanoseconds total_wall_time() const;
+
+        /// @brief get sum of the compile time of all phases
+        /// @returns duration
+        std::chrono::nanoseconds total_compile_time() const;
+
+        /// @brief get sum of the allocations of all phases
+        /// @returns number of bytes
+        uint64_t total_bytes_allocated() const;
+
+        /// @brief serialize as json object, durations are in nanoseconds
+        /// @returns string
+        std::string to_json() const;
+    };
+
+    /// @brief get measurements of jluna::initialize
+    /// @returns report, has no phases if initialize was not called with profile_startup = true
+    const StartupReport& startup_report();
+
+    namespace detail
+    {
+        // records StartupPhases into the report returned by jluna::startup_report, no-op if disabled
+        class StartupProfiler
+        {
+            public:
+                StartupProfiler(bool enabled);
+
+                // end current phase, if any, then start a new one
+                void begin(const std::string& name);
+
+                // end current phase, if any
+                void end();
+
+                // end current phase, then publish the report
+                void finish();
+
+            private:
+                bool _enabled;
+                bool _is_timing_compilation = false;
+
+                std::string _name;
+                std::chrono::steady_clock::time_point _start;
+                uint64_t _compile_time_start;
+                int64_t _bytes_start;
+
+                StartupReport _report;
+        };
+    }
+}
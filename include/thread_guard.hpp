@@ -0,0 +1,53 @@
+//
+// Copyright 2022 Clemens Cords
+// Created on 18.10.26 by clem (mail@clemens-cords.com)
+//
+
+#pragma once
+
+#include <include/julia_wrapper.hpp>
+
+// thread adoption was added to the C-API in Julia 1.9
+#if defined(JULIA_VERSION_MAJOR) and (JULIA_VERSION_MAJOR > 1 or (JULIA_VERSION_MAJOR == 1 and JULIA_VERSION_MINOR >= 9))
+    #define JLUNA_THREAD_ADOPTION_SUPPORTED 1
+#else
+    #define JLUNA_THREAD_ADOPTION_SUPPORTED 0
+#endif
+
+namespace jluna
+{
+    /// @brief allows the thread it is constructed in to safely access the Julia state, even if that thread is a C++-side thread, such as an std::thread.
+    /// On first use in a thread, the thread is adopted by the Julia runtime. While the guard is in scope, the thread counts as a Julia thread and blocks the garbage collector from running concurrently.
+    /// Once it goes out of scope, the garbage collector may run again, the thread may not access the Julia state until another guard is constructed
+    /// @note requires Julia 1.9 or newer. Guards may be nested, creating a guard in a thread that already is a Julia thread has no effect
+    class ThreadGuard
+    {
+        public:
+            /// @brief ctor, adopts the current thread if it is not yet known to Julia
+            /// @throws std::runtime_error if the current thread is not a Julia thread and the linked Julia version does not support thread adoption
+            ThreadGuard();
+
+            /// @brief dtor, restores the threads previous garbage collector state
+            ~ThreadGuard();
+
+            /// @brief copy ctor deleted
+            ThreadGuard(const ThreadGuard&) = delete;
+
+            /// @brief copy assignment deleted
+            ThreadGuard& operator=(const ThreadGuard&) = delete;
+
+            /// @brief can C++-side threads be adopted
+            /// @returns true if the linked Julia version is 1.9 or newer, false otherwise
+            static bool is_supported();
+
+            /// @brief can the current thread access the Julia state
+            /// @returns true if the thread is a Julia thread or was adopted previously, false otherwise
+            static bool is_julia_thread();
+
+        private:
+            #if JLUNA_THREAD_ADOPTION_SUPPORTED
+                jl_ptls_t _ptls = nullptr;
+                int8_t _state = 0;
+            #endif
+    };
+}
@@ -12,9 +12,16 @@
 
 namespace jluna
 {
+    namespace detail
+    {
+        void initialize_types();
+    }
+
     /// @brief forward declaration
     class Type : public Proxy
     {
+        friend void detail::initialize_types();
+
         public:
             /// @brief default ctor, construct as Nothing
             Type();
@@ -136,6 +143,9 @@ namespace jluna
             bool typename_is(const Type& other);
 
         private:
+            // construct from a type that is never garbage collected, used for the pre-initialized types below
+            Type(jl_datatype_t* value, bool is_permanent);
+
             jl_datatype_t* get() const;
     };
 
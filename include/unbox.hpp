@@ -146,7 +146,7 @@ namespace jluna
     template<is_usertype T>
     T unbox(unsafe::Value* value);
 
-    /// @brief unbox Base.ReentrantLock to jluna::Mutex
+    /// @brief unbox jluna.Mutex to jluna::Mutex
     class Mutex;
     template<is<Mutex> T>
     T unbox(unsafe::Value* value);
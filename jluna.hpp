@@ -23,3 +23,12 @@
 #include <include/module.hpp>
 #include <include/generator_expression.hpp>
 #include <include/usertype.hpp>
+#include <include/kernels.hpp>
+#include <include/broadcast.hpp>
+#include <include/coroutine.hpp>
+#include <include/channel.hpp>
+#include <include/thread_guard.hpp>
+#include <include/executor.hpp>
+#include <include/cancellation.hpp>
+#include <include/compiled_expression.hpp>
+#include <include/startup_report.hpp>